@@ -1,15 +1,37 @@
 #include "screenio.h"
+#if defined(__SSE2__)
+#include <immintrin.h>  // For the SSE2/AVX2 intrinsics of the grade aggregation kernel (see aggrGrades())
+#endif
 
 #define APPLICATION_MODE DEVELOPER_MODE   // primarily used to toggle DEBUG_MODE 
+#define DATA_FILE_FORMAT FMT_TEXT         // storage format of the data entry files (see data file format enumeration)
 
 // Application mode enumeration
 #define DEVELOPER_MODE LG_MODE_CONSL
 #define RELEASE_MODE LG_MODE_OFF
 
+// Data file format enumeration
+#define FMT_TEXT   0   // line-based text records
+#define FMT_BINARY 1   // fixed-size binary records preceded by a versioned header
+
 // Application resource properties
 #define TTL_MAIN "FOR SCHOOLS OF JAMAICA"
 #define DAT_MIN_SZ 1   // minimum allocatable capacity for a dynamic list
-#define DAT_EXT_SZ 10  // fixed capacity increment to be applied when extending a dynamic list
+#define DAT_EXT_SZ 10  // minimum capacity increment to be applied when extending a dynamic list
+#define DAT_EXT_DIV 2  // a dynamic list is extended by 1/DAT_EXT_DIV of its capacity (i.e. geometric growth)
+#define IDX_MIN_SZ 16  // minimum slot capacity for a list ID index (must be a power of 2)
+#define JRNL_CMPCT_MIN 64  // minimum no. of journaled operations before a journal is compacted into its data file
+#define JRNL_LN_SZ 128     // max. character width of a journaled operation record
+#define SQZ_DEAD_MIN 64    // minimum no. of tombstoned slots (ahead of its last live entry) before a reloaded list is compacted
+#define SQZ_DEAD_DIV 4     // a reloaded list is compacted once 1/SQZ_DEAD_DIV of its occupied slots are tombstoned
+#define CSV_LN_SZ 512      // max. character width of a CSV import record
+#define CSV_FLD_MAX 8      // max. no. of fields parsed per CSV import record
+#define PAGE_MIN_SZ 5      // minimum no. of table rows shown per page
+#define PAGE_HDR_SZ 20     // no. of console rows taken up by the headers, footers and prompts around a paged table
+#define PAGE_ROW_DIV 6     // when the console height is unknown, a page holds SCR_SIZE/PAGE_ROW_DIV table rows
+#define PAR_MIN_SZ 8192    // minimum no. of active enrollments tallied per worker thread when the stats cache is rebuilt
+#define PAR_MAX_THRDS 16   // max. no. of worker threads used to rebuild the stats cache
+#define GRADE_HIST_SZ 10   // no. of 10% bands in a grade histogram (a grade of 100% falls in the last band)
 
 // Screen display column sizes (measured in characters)
 #define ITEM_NO_SZ 4   
@@ -63,6 +85,7 @@
 // Application log resources
 #define APP_LOG_FILENAME        "AppLog.txt"
 #define APP_LOG_TITLE           "'FOR SCHOOLS OF JAMAICA' Application Log"
+#define APP_LOG_FMT             LOG_FMT_TEXT   // LOG_FMT_JSON or LOG_FMT_BIN produce logs for analysis tooling
 // Log messages
 #define MSG_ACTN_CONTD          "The current action may continue but render inconsistent results."
 #define MSG_ACTN_ABORT          "The current action will be aborted."
@@ -70,6 +93,7 @@
 //Screen messages
 #define MSG_INVALID_OPTION      "Invalid input. Please enter a valid option."
 #define MSG_EMPTY_LIST          "No items available\n\n"
+#define MSG_PAGE_NAV            "Enter N or P to change pages, or press ENTER to continue: "
 
 // Void data placeholders
 #define UNSPEC_DATA "<NONE>"   // frontend view label shown in the place of values not yet assigned or set
@@ -80,6 +104,24 @@
 #define STUDENT_DATA_FILENAME   "Students.txt"
 #define ENROLL_DATA_FILENAME    "Enrollments.txt"
 #define SUBJECT_DATA_FILENAME   "Subjects.txt"
+// Binary data entry file resources
+#define PRINCIPAL_BIN_FILENAME  "Principal.dat"
+#define TEACHER_BIN_FILENAME    "Teachers.dat"
+#define STUDENT_BIN_FILENAME    "Students.dat"
+#define ENROLL_BIN_FILENAME     "Enrollments.dat"
+#define SUBJECT_BIN_FILENAME    "Subjects.dat"
+// Data journal file resources (journals are kept in text format regardless of the data file format)
+#define ENROLL_JRNL_FILENAME    "Enrollments.jnl"
+#define TMP_DAT_EXT             ".tmp"   // extension of the temporary sibling file through which a data file is written
+#define LCK_DAT_EXT             ".lck"   // extension of the lock file that synchronizes access to a data file (and its journal)
+#define BIN_DAT_MAGIC           "FSJD"   // binary data file signature
+#define BIN_DAT_VERSION         1        // binary data file layout version (increment upon any persistent field change)
+#define DAT_RO_STAGED           ((FILE*) &ReadOnlyStage)   // handle of a read-only staging session
+
+// Journal operation enumeration
+#define JRNL_OP_ADD 'A'
+#define JRNL_OP_UPD 'U'
+#define JRNL_OP_DEL 'D'
 
 // User type enumeration
 #define USR_STUDENT   1
@@ -139,10 +181,143 @@ struct EnrollEntry {
 }
 DEF_ENROLL = {TRUE};  // default non-active enrollment entry
 
+struct BinDataHeader {
+    char magic [4];
+    int  version;
+    int  lst_type;
+    int  rec_sz;    // size of a record, i.e. the persistent fields of an entry (starting at entry.ID)
+    int  rec_cnt;
+};
+
+struct FileStamp {
+    long   fsz;      // file size (-1 = file does not exist)
+    time_t fmtm;     // file modification time
+    long   fid;      // file serial no. (changes whenever the file is replaced)
+};
+typedef struct FileStamp FStamp;
+
+struct DataStamp {   // generation stamp of the data (and journal) file of a list, as of the last time the list was loaded from it
+    FStamp dat;
+    FStamp jrnl;
+    time_t synced;   // time of the load; 0 = list not known to be in sync with its data file
+    int    skips;    // no. of staging sessions that skipped the reload
+    int    loads;    // no. of staging sessions that performed the reload
+};
+
+struct JournalSession {
+    FILE *fptr;      // journal file opened for appending; NULL = no save session in progress
+    void *bkp_list;  // copy of the list as staged (used to determine the operations to be journaled)
+    int   bkp_sz;
+    int   op_cnt;    // no. of operations held in the journal file
+    long  good_sz;   // byte offset just past the last complete (newline-terminated) operation replayed from the journal file
+};
+
+struct FreeSlotStack {
+    int *slots;      // indexes of tombstoned entries; the top holds the most recently freed slot
+    int  count;
+    int  capacity;
+};
+
+struct TombstoneMap {
+    unsigned int *deleted;   // deleted bitmap (32 slots per word); slots beyond the list are marked deleted
+    int  capacity;   // number of slots covered by the bitmap (a multiple of 32)
+    int  live_cnt;   // number of slots not marked deleted
+    int  valid_flg;  // FALSE until built (or when it cannot grow); counts revert to list scans
+};
+
+struct ListIndex {
+    int *slots;      // open-addressed hash slots holding (entry index + 1); 0 = empty, -1 = vacated
+    int  capacity;   // number of hash slots (always a power of 2)
+    int  count;      // number of occupied or vacated hash slots
+};
+
+struct EnrollIndex {
+    int *heads;      // hash bucket chain heads holding (entry index + 1); 0 = empty chain
+    int *links;      // per-entry chain links holding (next entry index + 1) in ascending entry order; 0 = end of chain
+    int  buckets;    // number of hash buckets (always a power of 2)
+    int  capacity;   // number of enrollment entries covered by links
+};
+
+struct EnrollStats {
+    int    type;       // key type (+ 1) of the entity as addressed in EnrollIndexes; 0 = empty slot
+    int    ID;
+    int    tallies [USR_TEACHER + 1];  // distinct enrolled-with tallies: [0] subjects, [USR_STUDENT] students, [USR_TEACHER] teachers
+    int    grade_cnt;  // number of graded active enrollments
+    double grade_sum;
+};
+
+struct EnrollPair {
+    int kind;          // pair kind (+ 1): [1] student-teacher, [2] student-subject, [3] teacher-subject; 0 = empty slot
+    int IDs [2];
+    int count;         // number of active enrollments sharing the pair
+};
+
+struct EnrollStatsCache {
+    struct EnrollStats *stats;  // open-addressed hash slots of the per-entity stats
+    struct EnrollPair  *pairs;  // open-addressed hash slots of the pair counts from which the distinct tallies are maintained
+    int    stats_cap, stats_cnt;
+    int    pairs_cap, pairs_cnt;
+    int    grade_cnt;  // school-wide graded active enrollments
+    double grade_sum;
+    int    valid_flg;  // FALSE until built (or when it could not be maintained); tallies revert to enrollment searches
+};
+
+struct EnrollColumns {
+    int   *keys [USR_TEACHER + 1];  // key columns: [0] subject ID (i.e. entry.ID), [USR_STUDENT] student ID, [USR_TEACHER] teacher ID
+    float *grades;     // (slot deletion is tracked by the enrollment list's tombstone map)
+    int    capacity;
+    int    size;       // no. of enrollment slots held; slots beyond it are deleted
+    int    valid_flg;  // FALSE until loaded (or when it cannot grow); scans revert to the enrollment list
+};
+
+struct GradeAggregate {
+    double sum;
+    int    count;
+    float  min, max;   // -1 if no grade was aggregated
+    int    hist [GRADE_HIST_SZ];
+};
+
+typedef void *ListLoader  (void*, int*, FILE*);
+typedef void *ListParser  (void*, int*, MCursor*);
+typedef FILE *ListSaver   (void*, int, FILE*);
+typedef int   IndexHook   (int, Entry*);
+typedef void  UnindexHook (int, Entry*);
+
+struct ListDescriptor {   // per-list-type properties and operations of a data list (resolved once per operation)
+    void **list;          // global data list (NULL for pointer lists)
+    int   *list_sz_ptr;
+    int    entry_sz;
+    void  *def_entry;     // default non-active entry that vacant slots are reset to
+    ListLoader  *load;    // text data file loader
+    ListParser  *parse;   // memory counterpart of load
+    ListSaver   *save;    // text data file saver
+    IndexHook   *index;   // lookup index hooks; NULL for unindexed list types
+    UnindexHook *unindex;
+};
+
+struct EnrollStatsPart {
+    struct EnrollStatsCache cache;  // partial stats of the enrollment range, merged once all the ranges are tallied
+    int from, to;
+};
+
 typedef struct tm Date;
 typedef struct UserEntry User;
 typedef struct SubjectEntry Subject;
 typedef struct EnrollEntry Enrollment;
+typedef struct BinDataHeader BinHeader;
+typedef struct DataStamp Stamp;
+typedef struct JournalSession Journal;
+typedef struct FreeSlotStack FreeList;
+typedef struct TombstoneMap TombMap;
+typedef struct ListIndex Index;
+typedef struct EnrollIndex MultiIndex;
+typedef struct EnrollStats Stats;
+typedef struct EnrollPair StatsPair;
+typedef struct EnrollStatsCache StatsCache;
+typedef struct EnrollStatsPart StatsPart;
+typedef struct EnrollColumns ColStore;
+typedef struct GradeAggregate GradeAggr;
+typedef struct ListDescriptor ListDesc;
 
 // List entry type size definition caching
 const int PTR_SZ = sizeof(void*);
@@ -150,6 +325,7 @@ const int CHAR_SZ = sizeof(char);
 const int USER_SZ = sizeof(User);
 const int ENROLL_SZ = sizeof(Enrollment);
 const int SUBJECT_SZ = sizeof(Subject);
+const int REC_OFFSET = sizeof(int) * 2;   // offset of the persistent fields (i.e. entry.ID) within any list entry
 
 const int FULL_NAME_SZ = FNAME_SZ + LNAME_SZ + 1;
 
@@ -165,17 +341,94 @@ User *Principal, *Students, *Teachers;
 int CURRENT_USR_TYPE;
 User* CURRENT_USR;
 
+char  ReadOnlyStage;   // address serves as the session handle returned for read-only staging (no file remains open)
+Stamp DataStamps  [LST_SUBJECT + 1];  // data file stamps of the global data lists (addressed by list type)
+Journal Journals  [LST_SUBJECT + 1];  // save session journals of the journaled data lists (addressed by list type)
+int   DataLocks   [LST_SUBJECT + 1];  // exclusive lock handles (+ 1) held by the save sessions of the global data lists; 0 = none
+FreeList FreeSlots [LST_SUBJECT + 1];  // tombstoned slots available for reuse in the global data lists (addressed by list type)
+TombMap Tombstones [LST_SUBJECT + 1];  // deleted bitmaps and live entry counts of the global data lists (addressed by list type)
+Index ListIndexes [LST_SUBJECT + 1];  // ID lookup indexes for the single-ID data lists (addressed by list type)
+MultiIndex EnrollIndexes [USR_TEACHER + 1];  // enrollment key indexes: [0] subject ID, [USR_STUDENT] student ID, [USR_TEACHER] teacher ID
+StatsCache EnrollStats;   // per-student, per-teacher and per-subject enrollment stats, maintained alongside EnrollIndexes
+ColStore   EnrollStore;   // columnar (structure-of-arrays) copy of the enrollment list scanned in place of it, maintained alongside EnrollIndexes
+
 // Function prototype declarations for functions whose invocations occur BEFORE their declaration.
 // Note that this is only necessary for static functions or functions that return pointer types.
 char *fsan(char*);
 char *vsan(char* attr, const char* mask);
 char *getDataFileName(int); 
+char *getFmtDataFileName(int, int); 
+char *getJrnlFileName(int); 
 int  *getDataListSzPtr(int);
 void *getDataList(int);
+int  getDataEntrySz(int);
 void *setDataListSz(void*, int);
+void *fitDataListSz(void*, int*, int);
 void *getEntry(int, void*, int);
 void *setEntry(int, void*, int, void*);
+void *replayListJournal(void*);
+Entry *addListEntry(int, void*);
+Entry *putListEntry(int, int, void*);
+Stamp *getDataStamp(int);
+void setDataStamp(int, Stamp*);
+int  isDataStampCurrent(int, const char*);
+int  isEntryType(int);
+void countDataStage(int, const char*, const int);
+Journal *getJournal(int);
+Index *getListIndex(int);
+TombMap *getTombMap(int);
+void pushFreeSlot(int, int);
+int  popFreeSlot(int);
+void markListEntry(int, int, int);
+int  countLiveEntries(int, int);
+Index *rebuildListIndex(int);
+int  isSqueezeDue(int);
+int  squeezeListData(int);
+int  getDataListType(void*);
+int  getEntryListType(Entry*);
+int  indexListEntry(int, Entry*);
+void unindexListEntry(int, Entry*);
+void clearListIndex(Index*);
+MultiIndex *getEnrollIndex(int);
+Stats *getEnrollStats(StatsCache*, int, int, int);
+StatsPair *getEnrollPair(StatsCache*, int, int, int, int);
+int  rebuildEnrollIndexes();
+ColStore *getEnrollStore();
+FILE *beginJrnlSession(int);
+void endJrnlSession(Journal*);
+int  commitJrnlSession(int, void*, int);
+int  compactListData(int);
+int  readDataStamp(int, const char*, Stamp*);
+int  readFileStamp(const char*, FStamp*);
+int  enrollSearch(int, int, int, int, int, Enrollment**, int);
+void deleteListEntry(Entry*);
 FILE *refreshListData(int, const int, const int, const int);
+ListDesc *getListDesc(int);
+User *loadUserData(User*, int*, FILE*);
+User *parseUserData(User*, int*, MCursor*);
+FILE *saveUserData(User*, int, FILE*);
+Enrollment *loadEnrollData(Enrollment*, int*, FILE*);
+Enrollment *parseEnrollData(Enrollment*, int*, MCursor*);
+FILE *saveEnrollData(Enrollment*, int, FILE*);
+Subject *loadSubjectData(Subject*, int*, FILE*);
+Subject *parseSubjectData(Subject*, int*, MCursor*);
+FILE *saveSubjectData(Subject*, int, FILE*);
+int  indexSnglEntry(int, Entry*);
+void unindexSnglEntry(int, Entry*);
+int  indexEnrollEntry(int, Enrollment*);
+void unindexEnrollEntry(int, Enrollment*);
+void compactDataScreen();
+void importDataScreen();
+void importFileScreen(int);
+
+ListDesc ListDescs [LST_PTR + 1] = {   // list type descriptors (addressed by list type)
+    [USR_STUDENT]   = {(void**) &Students,    &studentCapacity,   sizeof(User),       &DEF_USER,    (ListLoader*) loadUserData,    (ListParser*) parseUserData,    (ListSaver*) saveUserData,    indexSnglEntry, unindexSnglEntry},
+    [USR_TEACHER]   = {(void**) &Teachers,    &teacherCapacity,   sizeof(User),       &DEF_USER,    (ListLoader*) loadUserData,    (ListParser*) parseUserData,    (ListSaver*) saveUserData,    indexSnglEntry, unindexSnglEntry},
+    [USR_PRINCIPAL] = {(void**) &Principal,   &principalCapacity, sizeof(User),       &DEF_USER,    (ListLoader*) loadUserData,    (ListParser*) parseUserData,    (ListSaver*) saveUserData,    indexSnglEntry, unindexSnglEntry},
+    [LST_ENROLL]    = {(void**) &Enrollments, &enrollCapacity,    sizeof(Enrollment), &DEF_ENROLL,  (ListLoader*) loadEnrollData,  (ListParser*) parseEnrollData,  (ListSaver*) saveEnrollData,  (IndexHook*) indexEnrollEntry, (UnindexHook*) unindexEnrollEntry},
+    [LST_SUBJECT]   = {(void**) &Subjects,    &subjectCapacity,   sizeof(Subject),    &DEF_SUBJECT, (ListLoader*) loadSubjectData, (ListParser*) parseSubjectData, (ListSaver*) saveSubjectData, indexSnglEntry, unindexSnglEntry},
+    [LST_PTR]       = {NULL, NULL, sizeof(void*)}
+};
 
 
 /********************************************************************/
@@ -197,6 +450,11 @@ void* syncDataListSz(void *list, int *list_sz_ptr, FILE *fptr) {
     if (!freadInt(&data_sz, fptr)) 
         return NULL;
 
+    return fitDataListSz(list, list_sz_ptr, data_sz);
+}
+
+void* fitDataListSz(void *list, int *list_sz_ptr, int data_sz) {
+
     if (data_sz != *list_sz_ptr) 
     {
         if (list = setDataListSz(list, data_sz))
@@ -209,6 +467,8 @@ void* syncDataListSz(void *list, int *list_sz_ptr, FILE *fptr) {
 
 User *loadUserData(User *list, int *list_sz_ptr, FILE *fptr)  // NOTE: can produce partial loads upon failure
 {
+    int lst_type = getDataListType(list);
+
     if (list = syncDataListSz(list, list_sz_ptr, fptr))
 
     for (int i=0; i < *list_sz_ptr; i++) { 
@@ -222,14 +482,20 @@ User *loadUserData(User *list, int *list_sz_ptr, FILE *fptr)  // NOTE: can produ
             list[i].entry.deleted_flg = FALSE;
             list[i].entry.index = i;
         } 
-        else return NULL;   // assert parity between expected and actually loaded data
+        else {   // assert parity between expected and actually loaded data
+            list = NULL; break;
+        }
     }
 
+    rebuildListIndex(lst_type);   // re-synchronize list index with the (possibly partially) loaded entries
+
     return list;
 }
 
 Enrollment *loadEnrollData(Enrollment *list, int *list_sz_ptr, FILE *fptr)  // NOTE: can produce partial loads upon failure 
 {
+    int lst_type = getDataListType(list);
+
     if (list = syncDataListSz(list, list_sz_ptr, fptr))
 
     for (int i=0; i < *list_sz_ptr; i++) {
@@ -240,14 +506,20 @@ Enrollment *loadEnrollData(Enrollment *list, int *list_sz_ptr, FILE *fptr)  // N
             list[i].entry.deleted_flg = FALSE;
             list[i].entry.index = i;
         }
-        else return NULL;   // assert parity between expected and actually loaded data
+        else {   // assert parity between expected and actually loaded data
+            list = NULL; break;
+        }
     }
 
+    rebuildListIndex(lst_type);   // re-synchronize list index with the (possibly partially) loaded entries
+
     return list;
 }
 
 Subject *loadSubjectData(Subject *list, int *list_sz_ptr, FILE *fptr)  // NOTE: can produce partial loads upon failure 
 {
+    int lst_type = getDataListType(list);
+
     if (list = syncDataListSz(list, list_sz_ptr, fptr))
 
     for (int i=0; i < *list_sz_ptr; i++) {
@@ -256,8 +528,91 @@ Subject *loadSubjectData(Subject *list, int *list_sz_ptr, FILE *fptr)  // NOTE:
             list[i].entry.deleted_flg = FALSE;
             list[i].entry.index = i;
         }
-        else return NULL;   // assert parity between expected and actually loaded data
+        else {   // assert parity between expected and actually loaded data
+            list = NULL; break;
+        }
+    }
+
+    rebuildListIndex(lst_type);   // re-synchronize list index with the (possibly partially) loaded entries
+
+    return list;
+}
+
+User *parseUserData(User *list, int *list_sz_ptr, MCursor *cur)  // memory counterpart of loadUserData
+{
+    int lst_type = getDataListType(list);
+    int data_sz;
+
+    if (mreadInt(&data_sz, cur) && (list = fitDataListSz(list, list_sz_ptr, data_sz)))
+
+    for (int i=0; i < *list_sz_ptr; i++) { 
+        if (mreadInt (&list[i].entry.ID, cur)) {
+            mreadChars (list[i].Fname, FNAME_SZ, cur);
+            mreadChars (list[i].Lname, LNAME_SZ, cur);
+            mreadChars (list[i].Addr , ADDR_SZ, cur);
+            mreadChars (list[i].Dob  , DOB_SZ,   cur);
+            mreadInt   (&list[i].timeout, cur);
+            mreadInt   (&list[i].reg_stat, cur);
+            list[i].entry.deleted_flg = FALSE;
+            list[i].entry.index = i;
+        } 
+        else {   // assert parity between expected and actually loaded data
+            list = NULL; break;
+        }
+    }
+    else list = NULL;
+
+    rebuildListIndex(lst_type);
+
+    return list;
+}
+
+Enrollment *parseEnrollData(Enrollment *list, int *list_sz_ptr, MCursor *cur)  // memory counterpart of loadEnrollData
+{
+    int lst_type = getDataListType(list);
+    int data_sz;
+
+    if (mreadInt(&data_sz, cur) && (list = fitDataListSz(list, list_sz_ptr, data_sz)))
+
+    for (int i=0; i < *list_sz_ptr; i++) {
+        if (mreadInt  (&list[i].entry.ID, cur)) {
+            mreadInt  (&list[i].studentID, cur);
+            mreadInt  (&list[i].teacherID, cur);
+            mreadFloat (&list[i].grade, cur);
+            list[i].entry.deleted_flg = FALSE;
+            list[i].entry.index = i;
+        }
+        else {   // assert parity between expected and actually loaded data
+            list = NULL; break;
+        }
+    }
+    else list = NULL;
+
+    rebuildListIndex(lst_type);
+
+    return list;
+}
+
+Subject *parseSubjectData(Subject *list, int *list_sz_ptr, MCursor *cur)  // memory counterpart of loadSubjectData
+{
+    int lst_type = getDataListType(list);
+    int data_sz;
+
+    if (mreadInt(&data_sz, cur) && (list = fitDataListSz(list, list_sz_ptr, data_sz)))
+
+    for (int i=0; i < *list_sz_ptr; i++) {
+        if (mreadInt (&list[i].entry.ID, cur)) {
+            mreadChars (list[i].title, SUBJ_TTL_SZ, cur);
+            list[i].entry.deleted_flg = FALSE;
+            list[i].entry.index = i;
+        }
+        else {   // assert parity between expected and actually loaded data
+            list = NULL; break;
+        }
     }
+    else list = NULL;
+
+    rebuildListIndex(lst_type);
 
     return list;
 }
@@ -314,544 +669,2121 @@ FILE *saveSubjectData(Subject *list, int list_sz, FILE *fwptr)
     return fwptr;
 }
 
-FILE *stageListData(void *list, int *list_sz_ptr, const char *dat_fn, const int read_only_flg) { // used to initiate a save session
-    void* ptr;
+int isBinHeader(BinHeader *hdr, int lst_type) {   // determines if hdr belongs to a (compatible) binary data file of the given list type
+    return !memcmp(hdr->magic, BIN_DAT_MAGIC, sizeof(hdr->magic)) && hdr->version == BIN_DAT_VERSION && hdr->lst_type == lst_type 
+           && hdr->rec_sz == getDataEntrySz(lst_type) - REC_OFFSET && hdr->rec_cnt >= 0;
+}
 
-    FILE* fptr = fopen (dat_fn, "r");
-    if (fptr) 
+void *fillBinData(void *list, int *list_sz_ptr, BinHeader *hdr, const char *recs) {   // fills list with the given binary records
+    int entry_sz = getDataEntrySz(getDataListType(list));
+    Entry* e;
+
+    if ((list = fitDataListSz(list, list_sz_ptr, hdr->rec_cnt)))
     {
-        if (list == getDataList(LST_ENROLL)) {
-            ptr = loadEnrollData((Enrollment*)list, list_sz_ptr, fptr);
-        } else
-        if (list == getDataList(LST_SUBJECT)) {
-            ptr = loadSubjectData((Subject*)list, list_sz_ptr, fptr);
-        } else {
-            ptr = loadUserData((User*)list, list_sz_ptr, fptr);
+        for (int i=0; i < hdr->rec_cnt; i++) {
+            e = (Entry*) ((char*) list + i * entry_sz);
+            memcpy(&e->ID, recs + i * hdr->rec_sz, hdr->rec_sz);
+            e->deleted_flg = FALSE;
+            e->index = i;
         }
-        fclose(fptr); 
+    }
+    return list;
+}
 
-        if (!ptr) {
-            fptr = NULL;
-        }
-        if (!read_only_flg && ptr) {
-            fptr = fopen (dat_fn, "w");
-        }
+void *loadBinData(void *list, int *list_sz_ptr, FILE *fptr)   // NOTE: can produce partial loads upon failure 
+{
+    int lst_type = getDataListType(list);
+    BinHeader hdr;
+
+    if (!(fread(&hdr, sizeof(BinHeader), 1, fptr) == 1 && isBinHeader(&hdr, lst_type))) {
+        return NULL;   // not a (compatible) binary data file of the given list
     }
-    return fptr;
+
+    char* recs = malloc(datSz(hdr.rec_cnt) * hdr.rec_sz);
+
+    if (!(recs && fread(recs, hdr.rec_sz, hdr.rec_cnt, fptr) == (size_t) hdr.rec_cnt && (list = fillBinData(list, list_sz_ptr, &hdr, recs)))) {
+        list = NULL;
+    }
+
+    free(recs);
+    rebuildListIndex(lst_type);
+
+    return list;
 }
 
-int commitListData(void *list, int list_sz, FILE *fwptr) { // used to conclude a save session
-    void *ptr;
-  
-    if (list == getDataList(LST_ENROLL)) {
-        ptr = saveEnrollData((Enrollment*)list, list_sz, fwptr);
-    } else 
-    if (list == getDataList(LST_SUBJECT)) {
-        ptr = saveSubjectData((Subject*)list, list_sz, fwptr);
+void *parseBinData(void *list, int *list_sz_ptr, MCursor *cur)   // memory counterpart of loadBinData (records are copied straight from the mapping)
+{
+    int lst_type = getDataListType(list);
+    BinHeader hdr;
+
+    if (!((size_t) (cur->end - cur->pos) >= sizeof(BinHeader) && memcpy(&hdr, cur->pos, sizeof(BinHeader)) && isBinHeader(&hdr, lst_type))) {
+        return NULL;   // not a (compatible) binary data file of the given list
+    }
+    cur->pos += sizeof(BinHeader);
+
+    if (!((cur->end - cur->pos) / hdr.rec_sz >= hdr.rec_cnt && (list = fillBinData(list, list_sz_ptr, &hdr, cur->pos)))) {
+        list = NULL;
     } else {
-        ptr = saveUserData((User*)list, list_sz, fwptr);
+        cur->pos += hdr.rec_cnt * hdr.rec_sz;
     }
-    fclose(fwptr);
 
-    return ptr != NULL;
+    rebuildListIndex(lst_type);
+
+    return list;
 }
 
-int restoreListData(int lst_type, void *list, void *bkp_list, int bkp_sz) {
-    int cnt = 0;
+FILE *saveBinData(void *list, int list_sz, FILE *fwptr) 
+{
+    int lst_type = getDataListType(list);
+    int entry_sz = getDataEntrySz(lst_type);
+    int rec_cnt  = 0;
+    BinHeader hdr;
     Entry* e;
 
-    for (int i = 0; i < bkp_sz; i++) 
-    {
-        if (e = getEntry(-lst_type, bkp_list, i)) {
-            setEntry(lst_type, list, e->index, e);
+    memcpy(hdr.magic, BIN_DAT_MAGIC, sizeof(hdr.magic));
+    hdr.version  = BIN_DAT_VERSION;
+    hdr.lst_type = lst_type;
+    hdr.rec_sz   = entry_sz - REC_OFFSET;
+    hdr.rec_cnt  = getListEntryCnt(list, list_sz);
+
+    char* recs = malloc(datSz(hdr.rec_cnt) * hdr.rec_sz);
+    if  (!recs) {
+        return NULL;
+    }
+
+    for (int i = 0; i < list_sz && rec_cnt < hdr.rec_cnt; i++) {
+        e = (Entry*) ((char*) list + i * entry_sz);
+        if (!e->deleted_flg) {
+            memcpy(recs + rec_cnt++ * hdr.rec_sz, &e->ID, hdr.rec_sz);
         }
-    }    
-    return cnt;
-}
+    }
 
-int backupListData(int lst_type, void**list, int list_sz, void *bkp_list)
-{
+    if (fwrite(&hdr, sizeof(BinHeader), 1, fwptr) != 1 || fwrite(recs, hdr.rec_sz, rec_cnt, fwptr) != (size_t) rec_cnt) {
+        fwptr = NULL;
+    }
+    free(recs);
 
+    return fwptr;
 }
 
-FILE *reloadListData(int lst_type, const int read_only_flg, const int scr_psd_mode)  // used to reload data in public domain context
-{  
-    int*  list_sz_ptr = getDataListSzPtr(lst_type);
-    void* list        = getDataList(lst_type);
-    char* dat_fn      = getDataFileName(lst_type);
+void *loadListData(void *list, int *list_sz_ptr, FILE *fptr, const int dat_fmt) 
+{
+    ListDesc* ld = getListDesc(getDataListType(list));
 
-    FILE* fptr = stageListData(list, list_sz_ptr, dat_fn, read_only_flg);  
-    if (!fptr) {
-        sys_err (read_only_flg? NULL: LVL_FATAL, read_only_flg? MSG_ACTN_CONTD: MSG_ACTN_ABORT, scr_psd_mode, FALSE);
-    } 
-    return fptr;
+    if (!ld) {
+        return NULL;
+    }
+    return dat_fmt == FMT_BINARY? loadBinData(list, list_sz_ptr, fptr): ld->load(list, list_sz_ptr, fptr);
 }
 
-int persistListData(int lst_type, FILE *fwptr, const int scr_psd_mode) 
+void *mapListData(void *list, int *list_sz_ptr, const char *dat_fn, const int dat_fmt)   // loads list directly from a read-only memory mapping of its data file
 {
-    void* list = getDataList(lst_type);
+    ListDesc* ld = getListDesc(getDataListType(list));
+    long  fsz  = 0;
+    char* addr = ld? fmap(dat_fn, &fsz): NULL;
+    MCursor cur = {addr, addr + fsz};
 
-    if (!(list && commitListData(list, getDataListSz(lst_type, FALSE), fwptr))) {
-        sys_err (NULL, MSG_SAVE_ERROR, scr_psd_mode, FALSE);
-        return FALSE;
+    if (!addr) {
+        return NULL;
     }
-    return TRUE;
+
+    list = dat_fmt == FMT_BINARY? parseBinData(list, list_sz_ptr, &cur): ld->parse(list, list_sz_ptr, &cur);
+
+    funmap(addr, fsz);
+
+    return list;
 }
 
+FILE *saveListData(void *list, int list_sz, FILE *fwptr, const int dat_fmt) 
+{
+    ListDesc* ld = getListDesc(getDataListType(list));
 
-char* getRegStatDesc(int reg_stat_code, const int short_desc_flg) {
-    switch (reg_stat_code) {
-        case REG_STAT_PROF:
-            return short_desc_flg? "CREATED":"Pending Profile";
-        case REG_STAT_SUBJ:
-            return short_desc_flg? "PROFILED":"Pending Enrollment";
-        case REG_STAT_FULL:
-            return short_desc_flg? "FULL":"Completed";
-        default:
-            return NULL;
+    if (!ld) {
+        return NULL;
     }
+    return dat_fmt == FMT_BINARY? saveBinData(list, list_sz, fwptr): ld->save(list, list_sz, fwptr);
 }
 
-char* getFullName(User* usr) {
-    if (usr) {
-        static char full_name [FNAME_SZ + LNAME_SZ + 2];
+char *getTmpFileName(const char *dat_fn, char *tmp_fn) {   // NOTE: tmp_fn must hold at least FILENAME_MAX characters
+    snprintf(tmp_fn, FILENAME_MAX, "%s%s", dat_fn, TMP_DAT_EXT);
+    return tmp_fn;
+}
 
-        strcpy(full_name, vsan(usr->Fname, ""));
-        strcat(full_name, " ");
-        strcat(full_name, vsan(usr->Lname, ""));  
+FILE *openDataFile(const char *dat_fn, const int dat_fmt, const int write_flg) {   // NOTE: writes go to a temporary sibling file that replaces the data file upon commit
+    char tmp_fn [FILENAME_MAX];
 
-        return full_name;         
+    if (write_flg) {
+        dat_fn = getTmpFileName(dat_fn, tmp_fn);
     }
-    return NULL;
+    return fopen (dat_fn, dat_fmt == FMT_BINARY? (write_flg? "wb":"rb"): (write_flg? "w":"r"));
 }
 
-char* getTitle(const char* pre_ttl, int lst_type, const char* pst_ttl) {
+int commitDataFile(void *list, int list_sz, FILE *fwptr, const char *dat_fn, const int dat_fmt)   // saves list via the temporary file opened for dat_fn, then atomically renames it into place
+{
+    char tmp_fn [FILENAME_MAX];
+    int  result = saveListData(list, list_sz, fwptr, dat_fmt) && fsyncf(fwptr);
 
-    static char* title;
+    result = !fclose(fwptr) && result;
+    getTmpFileName(dat_fn, tmp_fn);
 
-    if (!title)
-        title = malloc(SCR_SIZE * CHAR_SZ);
+    if (!(result && freplace(tmp_fn, dat_fn))) {   // the data file is left intact upon failure
+        remove(tmp_fn);
+        return FALSE;
+    }
+    return TRUE;
+}
 
-    strcpy(title, "");  // clears any previously set title
-    
-    if (pre_ttl)
-        strcat(title, pre_ttl);
+int lockDataFile(const char *dat_fn, const int excl_flg) {
+    char lck_fn [FILENAME_MAX];
 
-    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+    snprintf(lck_fn, FILENAME_MAX, "%s%s", dat_fn, LCK_DAT_EXT);
+    return lockFile(lck_fn, excl_flg);
+}
 
-    switch (lst_type) {
-        case USR_STUDENT:
-            strcat(title, "STUDENT");
-            break;
-        case USR_TEACHER:
-            strcat(title, "TEACHER");
-            break;
-        case USR_PRINCIPAL:
-            strcat(title, "PRINCIPAL"); 
-            break; 
-        case LST_ENROLL:
-            strcat(title, "ENROLLMENT"); 
-            break;   
-        case LST_SUBJECT:
-           strcat(title, "SUBJECT");         
-    }
+int getDataLock(int lst_type) {
 
-    if (pst_ttl)
-        strcat(title, pst_ttl);
+    if (!lst_type) lst_type = CURRENT_USR_TYPE;
 
-    return title;
+    return isEntryType(lst_type)? DataLocks[lst_type] - 1: -1;
 }
 
-char* getDataFileName(int lst_type) {    //NOTE: references global application list resources
+int setDataLock(int lst_type, int lck) {
 
     if (!lst_type) lst_type = CURRENT_USR_TYPE;
 
-    switch (lst_type) {
-        case USR_STUDENT:
-            return STUDENT_DATA_FILENAME;
-        case USR_TEACHER:
-            return TEACHER_DATA_FILENAME;
-        case USR_PRINCIPAL:
-            return PRINCIPAL_DATA_FILENAME; 
-        case LST_ENROLL:
-           return ENROLL_DATA_FILENAME;
-        case LST_SUBJECT:
-           return SUBJECT_DATA_FILENAME;
-        default:
-           return NULL;        
+    if (!isEntryType(lst_type) || lck < 0) {
+        unlockFile(lck);
+        return FALSE;
     }
+    DataLocks[lst_type] = lck + 1;
+    return TRUE;
 }
 
-void* getDataList(int lst_type) {    //NOTE: references global application list resources
+void releaseDataLock(int lst_type) {
 
     if (!lst_type) lst_type = CURRENT_USR_TYPE;
 
-    switch (lst_type) {
-        case USR_STUDENT:
-            return Students;
-        case USR_TEACHER:
-            return Teachers;
-        case USR_PRINCIPAL:
-            return Principal;
-        case LST_ENROLL:
-            return Enrollments;  
-        case LST_SUBJECT:
-            return Subjects;    
-        default:
-            return NULL;        
+    if (isEntryType(lst_type)) {
+        unlockFile(DataLocks[lst_type] - 1);
+        DataLocks[lst_type] = 0;
     }
 }
 
-int* getDataListSzPtr(int lst_type) {    //NOTE: references global application data list resources
-    
-    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+FILE *stageListData(void *list, int *list_sz_ptr, const char *dat_fn, const int read_only_flg) { // used to initiate a save session
+    int lst_type = getDataListType(list);
+    int lck      = -1;
+    int skip_flg;
+    void* ptr    = list;
+    FILE* fptr;
+    Stamp stamp;
 
-    switch (lst_type) {
-        case USR_STUDENT:
-            return &studentCapacity;
-        case USR_TEACHER:
-            return &teacherCapacity;
-        case USR_PRINCIPAL:
-            return &principalCapacity;
-        case LST_ENROLL:
-            return &enrollCapacity;
-        case LST_SUBJECT:
-            return &subjectCapacity; 
-        default:
-            return NULL;            
+    // save sessions hold an exclusive lock until concluded (re-using the one held by an unconcluded session, if any),
+    // whereas read-only sessions hold a shared lock while loading only
+    if (!read_only_flg && getDataLock(lst_type) < 0 && !setDataLock(lst_type, lockDataFile(dat_fn, TRUE))) {
+        return NULL;
     }
-}
 
-int getDataListSz(int lst_type, const int dat_sz_flg) {
-    int* list_sz_ptr = getDataListSzPtr(lst_type);
-    int  list_sz     = list_sz_ptr? *list_sz_ptr:- 1; 
-    
-    return dat_sz_flg? datSz(list_sz): list_sz;
-}
+    skip_flg = isDataStampCurrent(lst_type, dat_fn);   // skip the reload when the data file is unchanged since the last one
 
-int getDataListCnt(int lst_type) {
-    int* list_sz_ptr = getDataListSzPtr(lst_type);
-    if (!list_sz_ptr) {
-        return -1;
+    countDataStage(lst_type, dat_fn, skip_flg);
+
+    if (read_only_flg && !skip_flg && getDataLock(lst_type) < 0) {
+        lck = lockDataFile(dat_fn, FALSE);   // NOTE: loading proceeds unsynchronized if the lock file is inaccessible
     }
-    return getListEntryCnt (getDataList(lst_type), *list_sz_ptr);
-}
 
-int getListEntryCnt(void *list, int list_sz) {
-    int cnt = 0;
-    int lst_type;
-    Entry* e;
+    if (!skip_flg) 
+    {
+        readDataStamp(lst_type, dat_fn, &stamp);   // stamp before loading so that any concurrent change is detected on the next session
 
-    // determine data list type of list
-    if (list == getDataList(LST_ENROLL)) {
-        lst_type = LST_ENROLL;  
-    } 
-    else 
-    if (list == getDataList(LST_SUBJECT)) {
-        lst_type = LST_SUBJECT;
+        if (read_only_flg) {
+            ptr = mapListData(list, list_sz_ptr, dat_fn, DATA_FILE_FORMAT);
+        } 
+        else if (fptr = openDataFile (dat_fn, DATA_FILE_FORMAT, FALSE)) {
+            ptr = loadListData(list, list_sz_ptr, fptr, DATA_FILE_FORMAT);
+            fclose(fptr); 
+        } 
+        else ptr = NULL;
+
+        if (ptr) {
+            ptr = replayListJournal(ptr);
+        }
+        if (ptr && isSqueezeDue(lst_type)) {
+            squeezeListData(lst_type);   // entry pointers are invalidated by the reload anyway
+        }
+        setDataStamp(lst_type, ptr? &stamp: NULL);
+        unlockFile(lck);
     }
-    else {
-        lst_type = -1;      // turn off global entry type checking for user lists
+
+    if (!read_only_flg) {
+        setDataStamp(lst_type, NULL);   // the list may diverge from its data file during a save session
     }
 
-    for (int i = 0; i < list_sz; i++) {
-        e = getEntry(lst_type, list, i);
-        if (!e->deleted_flg)
-            cnt++;
+    if (read_only_flg) {
+        return ptr? DAT_RO_STAGED: NULL;
+    }
+    if (ptr) {
+        // journaled lists are never rewritten; changes are appended to the journal instead
+        fptr = getJournal(lst_type)? beginJrnlSession(lst_type): openDataFile (dat_fn, DATA_FILE_FORMAT, TRUE);
+    }
+    if (!(ptr && fptr)) {
+        releaseDataLock(lst_type);
+        return NULL;
+    }
+    return fptr;
+}
+
+int commitListData(void *list, int list_sz, FILE *fwptr) { // used to conclude a save session
+    int lst_type  = getDataListType(list);
+    Journal* jrnl = getJournal(lst_type);
+    int result;
+
+    if (jrnl && jrnl->fptr && jrnl->fptr == fwptr) {
+        result = commitJrnlSession(lst_type, list, list_sz);
+    } else {
+        result = commitDataFile(list, list_sz, fwptr, getDataFileName(lst_type), DATA_FILE_FORMAT);
+    }
+    releaseDataLock(lst_type);
+
+    return result;
+}
+
+void discardListData(void *list, FILE *fwptr) { // used to abandon a save session (the data file is left untouched)
+    Journal* jrnl = getJournal(getDataListType(list));
+    char tmp_fn [FILENAME_MAX];
+
+    if (jrnl && jrnl->fptr && jrnl->fptr == fwptr) {
+        endJrnlSession(jrnl);
+    } else if (fwptr) {
+        fclose(fwptr);
+        remove(getTmpFileName(getDataFileName(getDataListType(list)), tmp_fn));
+    }
+    releaseDataLock(getDataListType(list));
+}
+
+int convertDataFile(int lst_type, const int src_fmt, const int dst_fmt)   // converts a data file between formats, via its global data list
+{
+    int*  list_sz_ptr = getDataListSzPtr(lst_type);
+    void* list        = getDataList(lst_type);
+    char* src_fn      = getFmtDataFileName(lst_type, src_fmt);
+    char* dst_fn      = getFmtDataFileName(lst_type, dst_fmt);
+    void* ptr         = NULL;
+    FILE* fptr;
+
+    if (list && (fptr = openDataFile(src_fn, src_fmt, FALSE))) 
+    {
+        ptr = loadListData(list, list_sz_ptr, fptr, src_fmt);
+        fclose(fptr);
+
+        if (!(ptr && (fptr = openDataFile(dst_fn, dst_fmt, TRUE)) && commitDataFile(getDataList(lst_type), *list_sz_ptr, fptr, dst_fn, dst_fmt))) {
+            ptr = NULL;
+        }
+    }
+    return ptr != NULL;
+}
+
+Journal* getJournal(int lst_type) {
+
+    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+
+    return getJrnlFileName(lst_type)? &Journals[lst_type]: NULL;
+}
+
+void endJrnlSession(Journal *jrnl) {
+    if (jrnl->fptr) {
+        fclose(jrnl->fptr);
+    }
+    free(jrnl->bkp_list);
+
+    jrnl->fptr     = NULL;
+    jrnl->bkp_list = NULL;
+    jrnl->bkp_sz   = 0;
+}
+
+FILE *beginJrnlSession(int lst_type) {   // opens the journal of the (staged) global data list for appending
+    Journal* jrnl = getJournal(lst_type);
+    void*    list = getDataList(lst_type);
+    int   list_sz = getDataListSz(lst_type, FALSE);
+    int  entry_sz = getDataEntrySz(lst_type);
+    FStamp fstmp;
+
+    endJrnlSession(jrnl);   // discard any unconcluded session
+
+    if (!(jrnl->bkp_list = malloc(datSz(list_sz) * entry_sz)))
+        return NULL;
+
+    memcpy(jrnl->bkp_list, list, list_sz * entry_sz);
+    jrnl->bkp_sz = list_sz;
+
+    // a torn tail left by an interrupted append must not prefix the operations appended next, 
+    // so the (replayed) list is folded into the data file, which discards the journal, before appending resumes
+    if (readFileStamp(getJrnlFileName(lst_type), &fstmp) && fstmp.fsz > jrnl->good_sz && !compactListData(lst_type)) {
+        endJrnlSession(jrnl);
+        return NULL;
+    }
+
+    if (!(jrnl->fptr = fopen(getJrnlFileName(lst_type), "a"))) {
+        endJrnlSession(jrnl);
+    }
+    return jrnl->fptr;
+}
+
+int journalEnroll(Journal *jrnl, char op, Enrollment *e) {
+    if (fprintf(jrnl->fptr, "%c %d %d %d %.2f\n", op, e->entry.ID, e->studentID, e->teacherID, e->grade) <= 0)
+        return FALSE;
+
+    jrnl->op_cnt++;
+    return TRUE;
+}
+
+int journalEnrollData(Journal *jrnl, Enrollment *list, int list_sz)   // appends the operations that turn the staged list into the given list
+{
+    Enrollment* bkp = jrnl->bkp_list;
+    Enrollment *e_old, *e_new;
+    int same_key_flg;
+    int max_sz = list_sz > jrnl->bkp_sz? list_sz: jrnl->bkp_sz;
+
+    for (int pass = 0; pass < 2; pass++)   // all deletions are journaled first, as re-added entries may occupy a different slot
+    for (int i = 0; i < max_sz; i++) 
+    {
+        e_old = i < jrnl->bkp_sz && !bkp[i].entry.deleted_flg ? bkp  + i: NULL;
+        e_new = i < list_sz      && !list[i].entry.deleted_flg? list + i: NULL;
+
+        if (e_old && e_new && !memcmp(&e_old->entry.ID, &e_new->entry.ID, ENROLL_SZ - REC_OFFSET))
+            continue;   // unchanged entry
+
+        same_key_flg = e_old && e_new && e_old->entry.ID == e_new->entry.ID && e_old->studentID == e_new->studentID;
+
+        if (!pass) {
+            if (e_old && !same_key_flg && !journalEnroll(jrnl, JRNL_OP_DEL, e_old))
+                return FALSE;
+        } 
+        else if (e_new && !journalEnroll(jrnl, same_key_flg? JRNL_OP_UPD: JRNL_OP_ADD, e_new))
+            return FALSE;
+    }
+    return TRUE;
+}
+
+void *replayListJournal(void *list)   // applies the journal of the (just loaded) global data list; journal operations are idempotent
+{
+    int lst_type  = getDataListType(list);
+    Journal* jrnl = getJournal(lst_type);
+    FILE* fptr;
+    Enrollment e = DEF_ENROLL, *enrolls_ptr [1];
+    int e_idx, tail, end;
+    char op, ln [JRNL_LN_SZ];
+
+    if (!jrnl) 
+        return list;
+
+    // added entries are appended after the last live entry (rather than reusing freed slots), 
+    // as per the order in which they would have been saved by a full rewrite
+    for (tail = getDataListSz(lst_type, FALSE); tail > 0 && ((Entry*) getEntry(lst_type, NULL, tail - 1))->deleted_flg; tail--);
+
+    jrnl->op_cnt  = 0;
+    jrnl->good_sz = 0;
+
+    if (!(fptr = fopen(getJrnlFileName(lst_type), "r")))
+        return list;   // nothing journaled since the last compaction
+
+    // NOTE: replay stops at a torn (i.e. partially appended) operation; only newline-terminated records are complete
+    while (fgets(ln, JRNL_LN_SZ, fptr) && strchr(ln, '\n')) 
+    {
+        end = 0;
+        if (sscanf(ln, " %c %d %d %d %f %n", &op, &e.entry.ID, &e.studentID, &e.teacherID, &e.grade, &end) != 5 || ln[end])
+            break;
+
+        e.entry.deleted_flg = FALSE;
+
+        if (enrollSearch(0, e.entry.ID, e.studentID, 0, 0, enrolls_ptr, 1)) {
+            if (op == JRNL_OP_DEL) {
+                deleteListEntry((Entry*) *enrolls_ptr);
+            } else {
+                e_idx = (*enrolls_ptr)->entry.index;
+
+                unindexListEntry(LST_ENROLL, (Entry*) *enrolls_ptr);   // re-key the updated entry
+                setEntry(LST_ENROLL, NULL, e_idx, &e);
+                indexListEntry(LST_ENROLL, (Entry*) *enrolls_ptr);
+            }
+        } 
+        else if (op != JRNL_OP_DEL && !putListEntry(LST_ENROLL, tail++, &e)) {
+            list = NULL; break;
+        }
+        jrnl->op_cnt++;
+        jrnl->good_sz = ftell(fptr);
+    }
+    fclose(fptr);
+
+    return list? getDataList(lst_type): NULL;
+}
+
+int compactListData(int lst_type)   // folds the journal of the global data list into its data file
+{
+    FILE* fptr = openDataFile(getDataFileName(lst_type), DATA_FILE_FORMAT, TRUE);
+
+    // the data file is replaced before the journal is removed; a crash in between merely replays operations already applied
+    if (!(fptr && commitDataFile(getDataList(lst_type), getDataListSz(lst_type, FALSE), fptr, getDataFileName(lst_type), DATA_FILE_FORMAT)))
+        return FALSE;
+
+    remove(getJrnlFileName(lst_type));
+    getJournal(lst_type)->op_cnt  = 0;
+    getJournal(lst_type)->good_sz = 0;
+
+    return TRUE;
+}
+
+int commitJrnlSession(int lst_type, void *list, int list_sz)   // used to conclude a save session of a journaled list
+{
+    Journal* jrnl = getJournal(lst_type);
+    int result    = journalEnrollData(jrnl, list, list_sz) && fsyncf(jrnl->fptr);
+
+    if (result) {
+        jrnl->good_sz = ftell(jrnl->fptr);   // the appended operations are complete
+    }
+    endJrnlSession(jrnl);
+
+    if (result && jrnl->op_cnt > JRNL_CMPCT_MIN + getListEntryCnt(list, list_sz) / 2) {
+        compactListData(lst_type);   // NOTE: the changes are already preserved by the journal even if compaction fails
+    }
+    return result;
+}
+
+int restoreListData(int lst_type, void *list, void *bkp_list, int bkp_sz) {
+    int cnt = 0;
+    Entry* e;
+
+    for (int i = 0; i < bkp_sz; i++) 
+    {
+        if (e = getEntry(-lst_type, bkp_list, i)) {
+            setEntry(lst_type, list, e->index, e);
+        }
+    }    
+    rebuildListIndex(lst_type);
+    setDataStamp(lst_type, NULL);
+
+    return cnt;
+}
+
+int backupListData(int lst_type, void**list, int list_sz, void *bkp_list)
+{
+
+}
+
+FILE *reloadListData(int lst_type, const int read_only_flg, const int scr_psd_mode)  // used to reload data in public domain context
+{  
+    int*  list_sz_ptr = getDataListSzPtr(lst_type);
+    void* list        = getDataList(lst_type);
+    char* dat_fn      = getDataFileName(lst_type);
+
+    FILE* fptr = stageListData(list, list_sz_ptr, dat_fn, read_only_flg);  
+    if (!fptr) {
+        scrLogTag(lst_type, 0, 0);
+        sys_err (read_only_flg? NULL: LVL_FATAL, read_only_flg? MSG_ACTN_CONTD: MSG_ACTN_ABORT, scr_psd_mode, FALSE);
+        scrLogTag(0, 0, 0);
+    } 
+    return fptr;
+}
+
+int persistListData(int lst_type, FILE *fwptr, const int scr_psd_mode) 
+{
+    void* list = getDataList(lst_type);
+
+    if (!(list && commitListData(list, getDataListSz(lst_type, FALSE), fwptr))) {
+        scrLogTag(lst_type, 0, 0);
+        sys_err (NULL, MSG_SAVE_ERROR, scr_psd_mode, FALSE);
+        scrLogTag(0, 0, 0);
+        return FALSE;
+    }
+    return TRUE;
+}
+
+
+char* getRegStatDesc(int reg_stat_code, const int short_desc_flg) {
+    switch (reg_stat_code) {
+        case REG_STAT_PROF:
+            return short_desc_flg? "CREATED":"Pending Profile";
+        case REG_STAT_SUBJ:
+            return short_desc_flg? "PROFILED":"Pending Enrollment";
+        case REG_STAT_FULL:
+            return short_desc_flg? "FULL":"Completed";
+        default:
+            return NULL;
+    }
+}
+
+char* getFullName(User* usr) {
+    if (usr) {
+        static char full_name [FNAME_SZ + LNAME_SZ + 2];
+
+        strcpy(full_name, vsan(usr->Fname, ""));
+        strcat(full_name, " ");
+        strcat(full_name, vsan(usr->Lname, ""));  
+
+        return full_name;         
+    }
+    return NULL;
+}
+
+char* getTitle(const char* pre_ttl, int lst_type, const char* pst_ttl) {
+
+    static char* title;
+
+    if (!title)
+        title = malloc(SCR_SIZE * CHAR_SZ);
+
+    strcpy(title, "");  // clears any previously set title
+    
+    if (pre_ttl)
+        strcat(title, pre_ttl);
+
+    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+
+    switch (lst_type) {
+        case USR_STUDENT:
+            strcat(title, "STUDENT");
+            break;
+        case USR_TEACHER:
+            strcat(title, "TEACHER");
+            break;
+        case USR_PRINCIPAL:
+            strcat(title, "PRINCIPAL"); 
+            break; 
+        case LST_ENROLL:
+            strcat(title, "ENROLLMENT"); 
+            break;   
+        case LST_SUBJECT:
+           strcat(title, "SUBJECT");         
+    }
+
+    if (pst_ttl)
+        strcat(title, pst_ttl);
+
+    return title;
+}
+
+char* getDataFileName(int lst_type) {    //NOTE: references global application list resources
+    return getFmtDataFileName(lst_type, DATA_FILE_FORMAT);
+}
+
+char* getJrnlFileName(int lst_type) {   // NOTE: only journaled list types have a journal file
+
+    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+
+    return lst_type == LST_ENROLL? ENROLL_JRNL_FILENAME: NULL;
+}
+
+char* getFmtDataFileName(int lst_type, const int dat_fmt) {
+
+    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+
+    if (dat_fmt == FMT_BINARY)
+    switch (lst_type) {
+        case USR_STUDENT:
+            return STUDENT_BIN_FILENAME;
+        case USR_TEACHER:
+            return TEACHER_BIN_FILENAME;
+        case USR_PRINCIPAL:
+            return PRINCIPAL_BIN_FILENAME; 
+        case LST_ENROLL:
+           return ENROLL_BIN_FILENAME;
+        case LST_SUBJECT:
+           return SUBJECT_BIN_FILENAME;
+        default:
+           return NULL;        
+    }
+
+    switch (lst_type) {
+        case USR_STUDENT:
+            return STUDENT_DATA_FILENAME;
+        case USR_TEACHER:
+            return TEACHER_DATA_FILENAME;
+        case USR_PRINCIPAL:
+            return PRINCIPAL_DATA_FILENAME; 
+        case LST_ENROLL:
+           return ENROLL_DATA_FILENAME;
+        case LST_SUBJECT:
+           return SUBJECT_DATA_FILENAME;
+        default:
+           return NULL;        
+    }
+}
+
+ListDesc* getListDesc(int lst_type) {
+
+    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+
+    return lst_type > 0 && lst_type <= LST_PTR? &ListDescs[lst_type]: NULL;
+}
+
+void* getDataList(int lst_type) {    //NOTE: references global application list resources
+    ListDesc* ld = getListDesc(lst_type);
+
+    return ld && ld->list? *ld->list: NULL;
+}
+
+int* getDataListSzPtr(int lst_type) {    //NOTE: references global application data list resources
+    ListDesc* ld = getListDesc(lst_type);
+
+    return ld? ld->list_sz_ptr: NULL;
+}
+
+int getDataListSz(int lst_type, const int dat_sz_flg) {
+    int* list_sz_ptr = getDataListSzPtr(lst_type);
+    int  list_sz     = list_sz_ptr? *list_sz_ptr:- 1; 
+    
+    return dat_sz_flg? datSz(list_sz): list_sz;
+}
+
+int getDataEntrySz(int lst_type) {
+    ListDesc* ld = getListDesc(lst_type);
+
+    return ld? ld->entry_sz: 0;
+}
+
+Stamp* getDataStamp(int lst_type) {
+
+    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+
+    return isEntryType(lst_type)? &DataStamps[lst_type]: NULL;
+}
+
+int readFileStamp(const char *fname, FStamp *fstmp) {
+    if (fstamp(fname, &fstmp->fsz, &fstmp->fmtm, &fstmp->fid))
+        return TRUE;
+
+    fstmp->fsz  = -1;
+    fstmp->fmtm = fstmp->fid = 0;
+    return FALSE;
+}
+
+int readDataStamp(int lst_type, const char *dat_fn, Stamp *stamp) {   // takes the current stamp of the data (and journal) file of the given list type
+    stamp->synced = time(NULL);
+    readFileStamp(getJrnlFileName(lst_type), &stamp->jrnl);
+
+    if (!readFileStamp(dat_fn, &stamp->dat)) {
+        stamp->synced = 0;
+    }
+    return stamp->synced != 0;
+}
+
+void setDataStamp(int lst_type, Stamp *src) {   // stamps the global data list as in sync with its data file (or clears the stamp when src is NULL)
+    Stamp* stamp = getDataStamp(lst_type);
+
+    if (stamp) {
+        if (src) {
+            stamp->dat  = src->dat;
+            stamp->jrnl = src->jrnl;
+        }
+        stamp->synced = src? src->synced: 0;
+    }
+}
+
+int isFileStampEqual(FStamp *a, FStamp *b) {
+    return a->fsz == b->fsz && a->fmtm == b->fmtm && a->fid == b->fid;
+}
+
+int isDataStampCurrent(int lst_type, const char *dat_fn) {   // determines if the data file is unchanged since the global data list was stamped
+    Stamp* stamp = getDataStamp(lst_type);
+    Stamp  curr;
+
+    // NOTE: a file modified within the same second as the stamp cannot be told apart by its mtime, hence it is never deemed current
+    return stamp && stamp->synced && readDataStamp(lst_type, dat_fn, &curr) 
+           && isFileStampEqual(&curr.dat, &stamp->dat) && isFileStampEqual(&curr.jrnl, &stamp->jrnl) 
+           && curr.dat.fmtm < stamp->synced && curr.jrnl.fmtm < stamp->synced;
+}
+
+void countDataStage(int lst_type, const char *dat_fn, const int skip_flg) {   // tallies (and debug logs) reloads skipped vs performed by data staging
+    Stamp* stamp = getDataStamp(lst_type);
+    char msg[SCR_SIZE];
+
+    if (!stamp) return;
+
+    if (skip_flg)
+        stamp->skips++;
+    else
+        stamp->loads++;
+
+    if (DEBUG_MODE) {
+        sprintf(msg, "%s reload %s (skipped: %d, performed: %d)", dat_fn, skip_flg? "skipped":"performed", stamp->skips, stamp->loads);
+        scrLogRec(LVL_DEBUG, lst_type, 0, 0, msg);
+    }
+}
+
+int getDataListCnt(int lst_type) {
+    int* list_sz_ptr = getDataListSzPtr(lst_type);
+    if (!list_sz_ptr) {
+        return -1;
+    }
+    return getListEntryCnt (getDataList(lst_type), *list_sz_ptr);
+}
+
+int getListEntryCnt(void *list, int list_sz) {
+    int lst_type = getDataListType(list);
+    int entry_sz = lst_type > 0? getDataEntrySz(lst_type): USER_SZ;   // lists other than the global data lists are counted as user lists
+    int cnt = 0;
+
+    if (lst_type > 0 && getTombMap(lst_type)->valid_flg) {   // counted from the deleted bitmap
+        return countLiveEntries(lst_type, list_sz);
+    }
+
+    for (int i = 0; i < list_sz; i++) {
+        if (!((Entry*) ((char*) list + i * entry_sz))->deleted_flg)
+            cnt++;
     }   
     return cnt;
 }
 
-void* setDataListSz(void *list, int new_sz) {    //NOTE: references global application data list resources
-    void* new_list;
-    int data_sz;
+void* setDataListSz(void *list, int new_sz) {    //NOTE: references global application data list resources
+    int lst_type = getDataListType(list);
+    ListDesc* ld = getListDesc(lst_type);
+    void* new_list;
+
+    if (!(ld && (new_list = realloc(list, datSz(new_sz) * ld->entry_sz)))) {
+        return NULL;
+    }
+    if (new_sz < *ld->list_sz_ptr) {   // discard index slots which may refer to truncated entries
+        clearListIndex(getListIndex(lst_type));
+    }
+    return *ld->list = new_list;
+}
+
+void reset(void *list, int lst_type, int offset, int count) 
+{
+    ListDesc* ld = getListDesc(lst_type);
+    int  glb_flg = list == getDataList(lst_type);
+    Entry* e;
+
+    if (!(ld && list)) {
+        return;
+    }
+    if (lst_type == LST_PTR) {
+        memset((void**) list + offset, 0, count * PTR_SZ);
+        return;
+    }
+
+    for (int i=offset; i < offset + count; i++) 
+    {
+        e = (Entry*) ((char*) list + i * ld->entry_sz);
+        memcpy(e, ld->def_entry, ld->entry_sz);
+        e->index = i;
+
+        if (glb_flg) {
+            markListEntry(lst_type, i, TRUE);
+        }
+    }
+}
+
+void* extDataList(int lst_type) 
+{
+    void* list = getDataList(lst_type);
+    if   (list) 
+    {
+        int* list_sz_ptr = getDataListSzPtr(lst_type);
+
+        int ext_sz = *list_sz_ptr / DAT_EXT_DIV < DAT_EXT_SZ ? DAT_EXT_SZ: *list_sz_ptr / DAT_EXT_DIV;
+
+        if (list = setDataListSz(list, *list_sz_ptr + ext_sz)) {
+            reset (list, lst_type, *list_sz_ptr, ext_sz);   // initializes the list
+
+            for (int i = *list_sz_ptr + ext_sz - 1; i >= *list_sz_ptr; i--) {   // pushed in reverse so that the new slots are reused in order
+                pushFreeSlot(lst_type, i);
+            }
+            (*list_sz_ptr) += ext_sz;
+        }
+    }
+    return list;
+}
+
+void* initDataList(int lst_type)    //NOTE: references global application data list resources
+{
+    ListDesc* ld = getListDesc(lst_type);
+
+    if  (ld && ld->list && !*ld->list) {
+        return *ld->list = calloc(DAT_MIN_SZ, ld->entry_sz);
+    }
+    return ld && ld->list? *ld->list: NULL; 
+}
+
+User* initUser(User *usr, int usr_type, int loginID) 
+{
+    if (usr && loginID > 0) {    
+        int tm_out;
+        switch (usr_type) {
+            case USR_STUDENT:
+                tm_out = TM_DEF_STUDENT;
+                break;
+            case USR_TEACHER:
+                tm_out = TM_DEF_TEACHER;
+                break;
+            case USR_PRINCIPAL:
+                tm_out = TM_DEF_PRINCIPAL;
+                break;
+            default:
+                return NULL;
+        }
+
+       *usr = DEF_USER;  // resets entity to a freshly initialized user
+        usr -> entry.ID = loginID;
+        usr -> timeout  = tm_out;
+        usr -> entry.deleted_flg = FALSE; 
+
+        return usr;
+    }
+    return NULL;
+}
+
+Enrollment* initEnroll(Enrollment *enroll, int subjID, int studID, int tchrID) 
+{
+    if (enroll && subjID > 0 && studID > 0 && tchrID > 0) 
+    {
+       *enroll = DEF_ENROLL;  // resets entity to a freshly initialized enrollment
+        enroll -> entry.ID  = subjID;
+        enroll -> studentID = studID;
+        enroll -> teacherID = tchrID;
+        enroll -> grade     = -1;
+        enroll -> entry.deleted_flg = FALSE;
+
+        return enroll;
+    }
+    return NULL;
+}
+
+Subject* initSubject(Subject *subj, int ID, const char* title) 
+{
+    if (subj && ID > 0 && !isEmptyStr(title, TRUE, NULL)) 
+    {
+       *subj = DEF_SUBJECT;  // resets entity to a freshly initialized subject
+        subj -> entry.ID = ID;
+        strcpy(subj->title, title);
+        subj -> entry.deleted_flg = FALSE;
+
+        return subj;
+    }
+    return NULL;
+}
+
+int isValidEntry(Entry* entry) {
+    return entry && !entry->deleted_flg && entry->ID > 0;
+}
+
+int isValidEnroll(Enrollment* enroll) {
+    return isValidEntry(enroll) && enroll->studentID > 0 && enroll->teacherID > 0;
+}
+
+int isValidSubject(Subject* subj) {
+    return isValidEntry(subj) && !isEmptyStr(subj->title, TRUE, NULL);
+}
+
+int isEntryType(int lst_type) {      // determies if lst_type is a valid global, application-defined list entry type
+    return lst_type == LST_ENROLL || isSnglEntryType(lst_type);
+}
+
+int isSnglEntryType(int lst_type) {  // determies if lst_type is a valid single-ID list entry type
+    return lst_type == LST_SUBJECT || isUsrType(lst_type);
+}
+
+int isUsrType(int lst_type) {
+    switch (lst_type) {
+        case USR_STUDENT:
+        case USR_TEACHER:
+        case USR_PRINCIPAL:
+            return TRUE;
+        default:
+            return !lst_type;   // current user type
+    }
+}
+
+void* getEntry(int lst_type, void* list, int index) {
+    return setEntry(lst_type, list, index, NULL);
+}
+
+void* setEntry(int lst_type, void* list, int index, void* entry) 
+{   // when lst_type is -ve, given list is not treated as a global data list
+    // i.e. global is not used if list is NULL and index is not checked for global list size exceed violation
+
+    const int glb_flg = lst_type > 0;
+    ListDesc* ld;
+    void* lst_entry;
+
+    if (index < 0)
+        return NULL;    
+                                
+    if (lst_type < 0) {           
+        lst_type = abs(lst_type);
+    } 
+    else if (index >= getDataListSz(lst_type, FALSE)) {
+        return NULL;
+    } 
+    else if (!list) {
+        list = getDataList(lst_type);
+    }
+
+    if (!(list && (ld = getListDesc(lst_type))))
+        return NULL;
+
+    lst_entry = (char*) list + index * ld->entry_sz;
+
+    if (lst_type == LST_PTR) {
+        *(void**) lst_entry = entry;
+    }
+    else if (entry) {
+        if (entry != lst_entry)
+            memcpy(lst_entry, entry, ld->entry_sz);
+
+        ((Entry*) lst_entry)->index = index;
+
+        if (glb_flg) {
+            markListEntry(lst_type, index, ((Entry*) lst_entry)->deleted_flg);
+        }
+    }
+
+    return lst_entry;
+}
+
+Entry* addListEntry(int lst_type, void *entry) {
+    // handle null reference
+    if (!(entry && isEntryType(lst_type))) {
+        return entry;
+    }
+
+    // handle invalid data list type
+    void*list = getDataList(lst_type);
+    if (!list) {
+        return NULL;
+    }
+
+    // add user to the most recently tombstoned slot (if any)
+    int list_sz = getDataListSz(lst_type, FALSE);
+    int i = popFreeSlot(lst_type);
+
+    // otherwise increase slot capacity and add user at the end
+    if (i < 0) {
+        if (!extDataList(lst_type))
+            return NULL;
+        if ((i = popFreeSlot(lst_type)) < 0)
+            i = list_sz;
+    }
+
+    return putListEntry(lst_type, i, entry);
+}
+
+Entry* putListEntry(int lst_type, int index, void *entry) {   // places entry at the given slot, extending the list until it holds the slot
+    Entry* e;
+
+    while (index >= getDataListSz(lst_type, FALSE)) {
+        if (!extDataList(lst_type))
+            return NULL;
+    }
+
+    e = setEntry(lst_type, NULL, index, entry);
+    indexListEntry(lst_type, e);
+    setDataStamp(lst_type, NULL);
+
+    return e;
+}
+
+void deleteListEntry(Entry *entry) {
+    if (entry) { 
+         int lst_type = getEntryListType(entry);
+
+         unindexListEntry(lst_type, entry);
+         setDataStamp(lst_type, NULL);
+         entry->deleted_flg = TRUE;
+         markListEntry(lst_type, entry->index, TRUE);
+         pushFreeSlot(lst_type, entry->index);
+    } 
+}
+
+FreeList* getFreeList(int lst_type) {
+
+    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+
+    return isEntryType(lst_type)? &FreeSlots[lst_type]: NULL;
+}
+
+void pushFreeSlot(int lst_type, int index) {   // NOTE: a slot that cannot be pushed is merely not reused until the stack is rebuilt
+    FreeList* fl = getFreeList(lst_type);
+    int* slots;
+
+    if (!fl) return;
+
+    if (fl->count == fl->capacity) {
+        if (!(slots = realloc(fl->slots, (fl->capacity < IDX_MIN_SZ ? IDX_MIN_SZ: fl->capacity * 2) * sizeof(int))))
+            return;
+        fl->slots    = slots;
+        fl->capacity = fl->capacity < IDX_MIN_SZ ? IDX_MIN_SZ: fl->capacity * 2;
+    }
+    fl->slots[fl->count++] = index;
+}
+
+int popFreeSlot(int lst_type) {   // returns the index of a tombstoned slot, or -1 if none is available
+    FreeList* fl = getFreeList(lst_type);
+    int list_sz  = getDataListSz(lst_type, FALSE);
+    int index;
+
+    while (fl && fl->count > 0) {
+        index = fl->slots[--fl->count];
+
+        // skip stale slots, i.e. those since reused or truncated
+        if (index < list_sz && ((Entry*) getEntry(lst_type, NULL, index))->deleted_flg) {
+            return index;
+        }
+    }
+    return -1;
+}
+
+void rebuildFreeSlots(int lst_type) {   // re-synchronizes the free-slot stack with the tombstoned entries of its global data list
+    FreeList* fl = getFreeList(lst_type);
+    char* list   = getDataList(lst_type);
+    int entry_sz = getDataEntrySz(lst_type);
+
+    if (!fl) return;
+
+    fl->count = 0;
+
+    if (list)
+    for (int i = getDataListSz(lst_type, FALSE) - 1; i >= 0; i--) {   // pushed in reverse so that the lowest slots are reused first
+        if (((Entry*) (list + i * entry_sz))->deleted_flg) {
+            pushFreeSlot(lst_type, i);
+        }
+    }
+}
+
+TombMap* getTombMap(int lst_type) {
+
+    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+
+    return isEntryType(lst_type)? &Tombstones[lst_type]: NULL;
+}
+
+int fitTombMap(TombMap *tm, int slot_cnt)   // ensures the bitmap covers the given no. of slots; the slots it is extended by are marked deleted
+{
+    int capacity = tm->capacity < IDX_MIN_SZ * 2 ? IDX_MIN_SZ * 2 : tm->capacity;
+    unsigned int* deleted;
+
+    if (slot_cnt <= tm->capacity && tm->deleted) {
+        return TRUE;
+    }
+    while (capacity < slot_cnt) {
+        capacity *= 2;
+    }
+    if (!(deleted = realloc(tm->deleted, capacity / 32 * sizeof(int)))) {
+        tm->valid_flg = FALSE;
+        return FALSE;
+    }
+    memset(deleted + tm->capacity / 32, 0xFF, (capacity - tm->capacity) / 32 * sizeof(int));
+
+    tm->deleted  = deleted;
+    tm->capacity = capacity;
+
+    return TRUE;
+}
+
+void markListEntry(int lst_type, int index, int deleted_flg)   // records the deletion status of a global list slot
+{
+    TombMap* tm = getTombMap(lst_type);
+    unsigned int bit = 1u << (index & 31);
+    unsigned int* word;
+
+    if (!(tm && tm->valid_flg && index >= 0 && fitTombMap(tm, index + 1))) {
+        return;
+    }
+    word = tm->deleted + (index >> 5);
+
+    if (!(*word & bit) == !deleted_flg) {
+        return;   // unchanged
+    }
+    *word ^= bit;
+    tm->live_cnt += deleted_flg? -1: 1;
+}
+
+void rebuildTombMap(int lst_type)   // re-synchronizes the deleted bitmap with the tombstoned entries of its global data list
+{
+    TombMap* tm  = getTombMap(lst_type);
+    char* list   = getDataList(lst_type);
+    int list_sz  = list? getDataListSz(lst_type, FALSE): 0;
+    int entry_sz = getDataEntrySz(lst_type);
+
+    if (!tm) return;
+
+    tm->valid_flg = fitTombMap(tm, list_sz);
+    tm->live_cnt  = 0;
+
+    if (!tm->valid_flg) return;
+
+    memset(tm->deleted, 0xFF, tm->capacity / 32 * sizeof(int));
+
+    for (int i = 0; i < list_sz; i++) {
+        if (!((Entry*) (list + i * entry_sz))->deleted_flg) {
+            tm->deleted[i >> 5] &= ~(1u << (i & 31));
+            tm->live_cnt++;
+        }
+    }
+}
+
+int countLiveEntries(int lst_type, int n)   // counts the live entries among the first n slots of a global data list (requires a valid bitmap)
+{
+    TombMap* tm = getTombMap(lst_type);
+    int cnt, words;
+
+    if (n >= tm->capacity) {
+        return tm->live_cnt;
+    }
+    cnt   = n;
+    words = n >> 5;
+
+    for (int w = 0; w < words; w++) {
+        cnt -= __builtin_popcount(tm->deleted[w]);
+    }
+    if (n & 31) {
+        cnt -= __builtin_popcount(tm->deleted[words] & ((1u << (n & 31)) - 1));
+    }
+    return cnt;
+}
+
+int nextLiveEntry(int lst_type, int index, int list_sz)   // gets the index of the first live entry at or after index, or -1 if none
+{
+    TombMap* tm = getTombMap(lst_type);
+    unsigned int live;
+
+    if (index < 0) {
+        return -1;
+    }
+
+    if (!(tm && tm->valid_flg)) {   // reverts to a list scan
+        for (; index < list_sz; index++) {
+            if (!((Entry*) getEntry(lst_type, NULL, index))->deleted_flg)
+                return index;
+        }
+        return -1;
+    }
+
+    // live slots are found a word at a time, skipping fully deleted words
+    for (int w = index >> 5; (w << 5) < list_sz && (w << 5) < tm->capacity; w++) {
+        live = ~tm->deleted[w];
+
+        if (w == index >> 5) {
+            live &= ~0u << (index & 31);
+        }
+        if (live) {
+            index = (w << 5) + __builtin_ctz(live);
+            return index < list_sz ? index : -1;
+        }
+    }
+    return -1;
+}
+
+int getDataListType(void *list) {    //NOTE: references global application data list resources
+    if (list)
+    for (int lst_type = USR_STUDENT; lst_type <= LST_SUBJECT; lst_type++) {
+        if (list == *ListDescs[lst_type].list)
+            return lst_type;
+    }
+    return -1;
+}
+
+int getEntryListType(Entry *entry) {    // determines the type of the global data list in which the given entry resides
+    int list_sz;
+    void* list;
+
+    if (entry)
+    for (int lst_type = USR_STUDENT; lst_type <= LST_SUBJECT; lst_type++) 
+    {
+        list    = getDataList(lst_type);
+        list_sz = getDataListSz(lst_type, FALSE);
+
+        if (list && list_sz > 0 && (void*) entry >= list && (void*) entry <= getEntry(lst_type, list, list_sz - 1)) {
+            return lst_type;
+        }
+    }
+    return -1;
+}
+
+int hashSlot(int key, int capacity) {   // multiplicative (Fibonacci) hashing of key onto a power of 2 capacity, i.e. the top log2(capacity) bits of the product
+    return capacity > 1 ? (int) ((unsigned int) key * 2654435761u >> (32 - __builtin_ctz(capacity))) : 0;
+}
+
+Index* getListIndex(int lst_type) {     // only single-ID entry list types are indexed
+    if (!lst_type) lst_type = CURRENT_USR_TYPE;
+
+    return lst_type > 0 && isSnglEntryType(lst_type) ? ListIndexes + lst_type : NULL;
+}
+
+void clearListIndex(Index *idx) {
+    if (idx && idx->slots) {
+        memset(idx->slots, 0, idx->capacity * sizeof(int));
+        idx->count = 0;
+    }
+}
+
+int putListIndex(Index *idx, Entry *entry) 
+{
+    int slot   = hashSlot(entry->ID, idx->capacity);
+    int vacant = -1;
+
+    for (int n = 0; n < idx->capacity && idx->slots[slot]; n++, slot = (slot + 1) & (idx->capacity - 1)) 
+    {
+        if (idx->slots[slot] == entry->index + 1) {
+            return TRUE;   // entry already indexed
+        }
+        if (idx->slots[slot] < 0 && vacant < 0) {
+            vacant = slot;
+        }
+    }
+
+    if (vacant < 0) {
+        if (idx->slots[slot])
+            return FALSE;  // no free slot (never occurs while the load factor is maintained)
+        vacant = slot;
+        idx->count++;
+    }
+    idx->slots[vacant] = entry->index + 1;
+
+    return TRUE;
+}
+
+Index* rebuildListIndex(int lst_type)   // re-synchronizes a list ID index (and free-slot stack) with the entries of its global data list
+{
+    rebuildFreeSlots(lst_type);
+    rebuildTombMap(lst_type);
+
+    if (lst_type == LST_ENROLL) {   // enrollments are indexed by their key attributes rather than a single ID
+        rebuildEnrollIndexes();
+    }
+
+    Index* idx = getListIndex(lst_type);
+    if  (!idx) {
+        return NULL;
+    }
+
+    void* list  = getDataList(lst_type);
+    int list_sz = getDataListSz(lst_type, FALSE);
+    int entry_sz = getDataEntrySz(lst_type);
+    int capacity = idx->capacity < IDX_MIN_SZ ? IDX_MIN_SZ : idx->capacity;
+    Entry* e;
+
+    while (capacity < list_sz * 2) {   // maintain a load factor of at most 1/2
+        capacity *= 2;
+    }
+
+    if (capacity != idx->capacity) 
+    {
+        int* slots = realloc(idx->slots, capacity * sizeof(int));
+
+        if (!slots) {   // disable the index; lookups revert to list scans
+            free(idx->slots);
+            idx->slots = NULL;
+            idx->capacity = idx->count = 0;
+            return NULL;
+        }
+        idx->slots    = slots;
+        idx->capacity = capacity;
+    }
+
+    clearListIndex(idx);
+
+    if (list)
+    for (int i = 0; i < list_sz; i++) {
+        e = (Entry*) ((char*) list + i * entry_sz);
+        if (!e->deleted_flg) {
+            putListIndex(idx, e);
+        }
+    }
+
+    return idx;
+}
+
+int countDeadSlots(int lst_type, int *occ_sz_ptr)   // counts the tombstoned slots lying ahead of the last live entry of a global data list
+{
+    TombMap* tm = getTombMap(lst_type);
+    int occ_sz  = getDataListSz(lst_type, FALSE);
+    int live    = 0;
+
+    while (occ_sz > 0 && ((Entry*) getEntry(lst_type, NULL, occ_sz - 1))->deleted_flg) {
+        occ_sz--;   // trailing tombstones (i.e. spare capacity) are not counted
+    }
+    if (occ_sz_ptr) *occ_sz_ptr = occ_sz;
+
+    if (tm && tm->valid_flg) {
+        return occ_sz - tm->live_cnt;
+    }
+    for (int i = 0; i < occ_sz; i++) {
+        live += !((Entry*) getEntry(lst_type, NULL, i))->deleted_flg;
+    }
+    return occ_sz - live;
+}
+
+int isSqueezeDue(int lst_type) {   // determines if enough of the occupied slots of a global data list are tombstoned to warrant compaction
+    int occ_sz;
+    int dead = countDeadSlots(lst_type, &occ_sz);
+
+    return dead >= SQZ_DEAD_MIN && dead * SQZ_DEAD_DIV >= occ_sz;
+}
+
+int squeezeListData(int lst_type)   // compacts a global data list by moving its live entries (in order) ahead of its tombstoned slots; returns the no. of slots reclaimed
+{   // NOTE: invalidates any entry pointers held into the list other than CURRENT_USR
+    void* list  = getDataList(lst_type);
+    int list_sz = getDataListSz(lst_type, FALSE);
+    int usr_idx = -1;
+    int live    = 0;
+    int occ_sz  = 0;
+    Entry* e;
+
+    if (!(list && isEntryType(lst_type))) {
+        return 0;
+    }
+    if (CURRENT_USR && getEntryListType((Entry*) CURRENT_USR) == lst_type) {
+        usr_idx = CURRENT_USR->entry.index;
+    }
+
+    for (int i = 0; i < list_sz; i++) 
+    {
+        e = getEntry(lst_type, list, i);
+        if (e->deleted_flg) continue;
+
+        if (i == usr_idx) {
+            CURRENT_USR = getEntry(lst_type, list, live);
+        }
+        if (i != live) {
+            setEntry(lst_type, list, live, e);   // also re-assigns the entry index
+        }
+        occ_sz = i + 1;
+        live++;
+    }
+
+    if (occ_sz == live) {
+        return 0;   // no tombstone lies ahead of the last live entry
+    }
+    reset(list, lst_type, live, occ_sz - live);   // the vacated slots become spare capacity
+    rebuildListIndex(lst_type);                   // slot-based structures (ID/key indexes, free slots, bitmap, stats, column store) are re-synchronized
+
+    return occ_sz - live;
+}
+
+int indexListEntry(int lst_type, Entry *entry) 
+{
+    ListDesc* ld = getListDesc(lst_type);
+
+    return ld && ld->index? ld->index(lst_type, entry): FALSE;
+}
+
+void unindexListEntry(int lst_type, Entry *entry)  // NOTE: must be invoked before the entry ID is altered
+{
+    ListDesc* ld = getListDesc(lst_type);
+
+    if (ld && ld->unindex) {
+        ld->unindex(lst_type, entry);
+    }
+}
+
+int indexSnglEntry(int lst_type, Entry *entry) 
+{
+    Index* idx = getListIndex(lst_type);
+
+    if (!(idx && entry) || entry->deleted_flg) {
+        return FALSE;
+    }
+
+    if ((idx->count + 1) * 2 > idx->capacity) {     // load factor exceeded (or index not yet allocated)
+        return rebuildListIndex(lst_type) != NULL;  // entry already resides in its list, so the rebuild includes it
+    }
+
+    return putListIndex(idx, entry);
+}
+
+void unindexSnglEntry(int lst_type, Entry *entry)  // NOTE: must be invoked before the entry ID is altered
+{
+    Index* idx = getListIndex(lst_type);
+
+    if (!(idx && idx->capacity && entry)) {
+        return;
+    }
+
+    int slot = hashSlot(entry->ID, idx->capacity);
+
+    for (int n = 0; n < idx->capacity && idx->slots[slot]; n++, slot = (slot + 1) & (idx->capacity - 1)) {
+        if (idx->slots[slot] == entry->index + 1) {
+            idx->slots[slot] = -1;
+            return;
+        }
+    }
+}
+
+int findListIndex(int lst_type, int entryID)   // returns the list index of the active entry with the given ID, or -1 if not found
+{
+    Index* idx  = getListIndex(lst_type);
+    void* list  = getDataList(lst_type);
+    Entry* e;
+
+    int slot = hashSlot(entryID, idx->capacity);
+
+    for (int n = 0; n < idx->capacity && idx->slots[slot]; n++, slot = (slot + 1) & (idx->capacity - 1)) 
+    {
+        if (idx->slots[slot] > 0) {
+            e = getEntry(lst_type, list, idx->slots[slot] - 1);
+
+            if (e && !e->deleted_flg && e->ID == entryID) {
+                return e->index;
+            }
+        }
+    }
+    return -1;
+}
+
+MultiIndex* getEnrollIndex(int usr_type) {
+    switch (abs(usr_type)) {
+        case USR_STUDENT:
+            return EnrollIndexes + USR_STUDENT;
+        case USR_TEACHER:
+            return EnrollIndexes + USR_TEACHER;
+        default:
+            return EnrollIndexes;   // subject ID
+    }
+}
+
+int getEnrollKey(int usr_type, Enrollment* e) {  // gets the index key of an enrollment regardless of its deletion status
+    switch (abs(usr_type)) {
+        case USR_STUDENT:
+            return e->studentID;
+        case USR_TEACHER:
+            return e->teacherID;
+        default:
+            return e->entry.ID;
+    }
+}
+
+int linkEnrollEntry(MultiIndex *idx, int key, Enrollment *e)  // links the entry into its bucket chain, preserving ascending entry order
+{
+    int* link = idx->heads + hashSlot(key, idx->buckets);
+
+    while (*link && *link - 1 < e->entry.index) {
+        link = idx->links + *link - 1;
+    }
+    if (*link - 1 != e->entry.index) {
+        idx->links[e->entry.index] = *link;
+        *link = e->entry.index + 1;
+        return TRUE;
+    }
+    return FALSE;   // already linked
+}
+
+int unlinkEnrollEntry(MultiIndex *idx, int key, Enrollment *e) 
+{
+    int* link = idx->heads + hashSlot(key, idx->buckets);
+
+    while (*link && *link - 1 < e->entry.index) {
+        link = idx->links + *link - 1;
+    }
+    if (*link - 1 == e->entry.index) {
+        *link = idx->links[e->entry.index];
+        idx->links[e->entry.index] = 0;
+        return TRUE;
+    }
+    return FALSE;   // not linked
+}
+
+int getEnrollKeyType(int usr_type) {   // gets the EnrollIndexes (and stats tallies) address of a key type
+    return (int) (getEnrollIndex(usr_type) - EnrollIndexes);
+}
+
+Stats* getEnrollStats(StatsCache *c, int usr_type, int entryID, int add_flg)  // finds (or adds, when room is reserved) the stats of a student, teacher or subject
+{
+    int type = getEnrollKeyType(usr_type) + 1;
+    int slot = c->stats_cap? hashSlot(entryID * 4 + type, c->stats_cap): 0;
+    Stats* s;
+
+    for (int n = 0; n < c->stats_cap; n++, slot = (slot + 1) & (c->stats_cap - 1)) {
+        s = c->stats + slot;
+
+        if (s->type == type && s->ID == entryID) {
+            return s;
+        }
+        if (!s->type) {
+            if (!add_flg || (c->stats_cnt + 1) * 2 > c->stats_cap) 
+                return NULL;
+
+            memset(s, 0, sizeof(Stats));
+            s->type = type;
+            s->ID   = entryID;
+            c->stats_cnt++;
+            return s;
+        }
+    }
+    return NULL;
+}
+
+StatsPair* getEnrollPair(StatsCache *c, int kind, int ID_a, int ID_b, int add_flg)  // finds (or adds, when room is reserved) the count of a pair of enrollment keys
+{
+    int slot = c->pairs_cap? hashSlot((ID_a * 31 + ID_b) * 4 + kind + 1, c->pairs_cap): 0;
+    StatsPair* p;
+
+    for (int n = 0; n < c->pairs_cap; n++, slot = (slot + 1) & (c->pairs_cap - 1)) {
+        p = c->pairs + slot;
+
+        if (p->kind == kind + 1 && p->IDs[0] == ID_a && p->IDs[1] == ID_b) {
+            return p;
+        }
+        if (!p->kind) {
+            if (!add_flg || (c->pairs_cnt + 1) * 2 > c->pairs_cap) 
+                return NULL;
+
+            p->kind   = kind + 1;
+            p->IDs[0] = ID_a;
+            p->IDs[1] = ID_b;
+            p->count  = 0;
+            c->pairs_cnt++;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+int reserveEnrollStats(StatsCache *c, int stats_cnt, int pairs_cnt)  // ensures room for the given number of additional stats and pairs, rehashing as required
+{
+    StatsCache old = *c;
+    int stats_cap = c->stats_cap < IDX_MIN_SZ ? IDX_MIN_SZ : c->stats_cap;
+    int pairs_cap = c->pairs_cap < IDX_MIN_SZ ? IDX_MIN_SZ : c->pairs_cap;
+
+    while ((c->stats_cnt + stats_cnt) * 2 > stats_cap) {   // maintain a load factor of at most 1/2
+        stats_cap *= 2;
+    }
+    while ((c->pairs_cnt + pairs_cnt) * 2 > pairs_cap) {
+        pairs_cap *= 2;
+    }
+
+    if (stats_cap == c->stats_cap && pairs_cap == c->pairs_cap) {
+        return TRUE;
+    }
+
+    c->stats = calloc(stats_cap, sizeof(Stats));
+    c->pairs = calloc(pairs_cap, sizeof(StatsPair));
+
+    if (!(c->stats && c->pairs)) {   // keep the current slots; the caller disables the cache
+        free(c->stats);
+        free(c->pairs);
+        *c = old;
+        return FALSE;
+    }
+    c->stats_cap = stats_cap; c->stats_cnt = 0;
+    c->pairs_cap = pairs_cap; c->pairs_cnt = 0;
+
+    // rehashing drops pairs no longer shared by any enrollment
+    for (int i = 0; i < old.stats_cap; i++) {
+        if (old.stats[i].type) {
+            *getEnrollStats(c, old.stats[i].type - 1 ? old.stats[i].type - 1 : LST_SUBJECT, old.stats[i].ID, TRUE) = old.stats[i];
+        }
+    }
+    for (int i = 0; i < old.pairs_cap; i++) {
+        if (old.pairs[i].kind && old.pairs[i].count) {
+            getEnrollPair(c, old.pairs[i].kind - 1, old.pairs[i].IDs[0], old.pairs[i].IDs[1], TRUE)->count = old.pairs[i].count;
+        }
+    }
+    free(old.stats);
+    free(old.pairs);
+
+    return TRUE;
+}
+
+void tallyEnrollEntry(StatsCache *c, Enrollment *e, int sign)  // adds (+1) or removes (-1) an active enrollment from a stats cache
+{
+    static const int usr_types  []    = {LST_SUBJECT, USR_STUDENT, USR_TEACHER};
+    static const int pair_types [][2] = {{USR_STUDENT, USR_TEACHER}, {USR_STUDENT, LST_SUBJECT}, {USR_TEACHER, LST_SUBJECT}};
+
+    Stats *s [USR_TEACHER + 1];
+    StatsPair* p;
+    int a, b;
+
+    if (!c->valid_flg) {
+        return;
+    }
+
+    if (sign > 0 && !reserveEnrollStats(c, 3, 3)) {
+        c->valid_flg = FALSE;
+        return;
+    }
+
+    for (int k = 0; k < 3; k++) {
+        if (!(s[k] = getEnrollStats(c, usr_types[k], getEnrollKey(usr_types[k], e), sign > 0))) {
+            c->valid_flg = FALSE;   // untallied entry (never occurs while the cache is in sync)
+            return;
+        }
+    }
+
+    for (int k = 0; k < 3; k++) {
+        a = getEnrollKeyType(pair_types[k][0]);
+        b = getEnrollKeyType(pair_types[k][1]);
+        p = getEnrollPair(c, k, s[a]->ID, s[b]->ID, sign > 0);
+
+        if (!p || (sign < 0 && !p->count)) {
+            c->valid_flg = FALSE;
+            return;
+        }
+
+        p->count += sign;
+
+        // a distinct tally only changes when the first enrollment of a pair is added, or its last one removed
+        if (sign > 0 ? p->count == 1 : p->count == 0) {
+            s[a]->tallies[b] += sign;
+            s[b]->tallies[a] += sign;
+        }
+    }
 
-    // determine the entry size based on the supported list type
-    if (list == NULL) {
-        return list;
-    } else if (list == Enrollments) {
-        data_sz = ENROLL_SZ;
-    } else if (list == Subjects) {
-        data_sz = SUBJECT_SZ;
-    } else {
-        data_sz = USER_SZ;
+    if (e->grade >= 0) {
+        for (int k = 0; k < 3; k++) {
+            s[k]->grade_cnt += sign;
+            s[k]->grade_sum += sign * e->grade;
+        }
+        c->grade_cnt += sign;
+        c->grade_sum += sign * e->grade;
     }
+}
+
+void tallyEnrollRange(void *arg)   // tallies the active enrollments of a range into its partial stats (run by worker threads)
+{
+    StatsPart* part = arg;
+    Enrollment* enrolls = getDataList(LST_ENROLL);
 
-    new_list = realloc(list, datSz(new_sz) * data_sz);
+    part->cache.valid_flg = TRUE;
 
-    if (new_list) {
-        // determine the list to set based on the supported list type
-        if (list == Enrollments) {
-            return Enrollments = new_list;
-        } else if (list == Subjects) {
-            return Subjects = new_list;
-        } else if (list == Students) {
-            return Students = new_list;
-        } else if (list == Teachers) {
-            return Teachers = new_list;
+    for (int i = part->from; i < part->to && part->cache.valid_flg; i++) {
+        if (!enrolls[i].entry.deleted_flg) {
+            tallyEnrollEntry(&part->cache, enrolls + i, 1);
         }
     }
-    return NULL;
 }
 
-void reset(void *list, int lst_type, int offset, int count) 
+int mergeEnrollStats(StatsCache *c, StatsCache *part)   // merges partial stats into a stats cache; distinct tallies are recounted from the merged pairs
 {
-    void* def_value;
+    Stats *s, *s_a, *s_b;
+    StatsPair* p;
 
-    switch (lst_type) {
-        case LST_PTR:
-            def_value = NULL;
-            break;
-        case LST_ENROLL:
-            def_value = &DEF_ENROLL;
-            break;
-        case LST_SUBJECT:
-            def_value = &DEF_SUBJECT;
-            break;
-        default:
-            def_value = &DEF_USER;
+    if (!(part->valid_flg && reserveEnrollStats(c, part->stats_cnt, part->pairs_cnt))) {
+        return FALSE;
     }
 
-    for (int i=offset; i < offset + count; i++) {
-        setEntry(-lst_type, list, i, def_value);
+    for (int i = 0; i < part->stats_cap; i++) {
+        if (part->stats[i].type) {
+            s = getEnrollStats(c, part->stats[i].type - 1 ? part->stats[i].type - 1 : LST_SUBJECT, part->stats[i].ID, TRUE);
+            s->grade_cnt += part->stats[i].grade_cnt;
+            s->grade_sum += part->stats[i].grade_sum;
+        }
     }
-}
 
-void* extDataList(int lst_type) 
-{
-    void* list = getDataList(lst_type);
-    if   (list) 
-    {
-        int* list_sz_ptr = getDataListSzPtr(lst_type);
+    // pair kinds (as per tallyEnrollEntry()) by the key types of their IDs
+    static const int pair_keys [][2] = {{USR_STUDENT, USR_TEACHER}, {USR_STUDENT, 0}, {USR_TEACHER, 0}};
+
+    for (int i = 0; i < part->pairs_cap; i++) {
+        if (part->pairs[i].kind && part->pairs[i].count) {
+            int k = part->pairs[i].kind - 1;
+            p = getEnrollPair(c, k, part->pairs[i].IDs[0], part->pairs[i].IDs[1], TRUE);
 
-        if (list = setDataListSz(list, *list_sz_ptr + DAT_EXT_SZ)) {
-            reset (list, lst_type, *list_sz_ptr, DAT_EXT_SZ);   // initializes the list
-            (*list_sz_ptr) += DAT_EXT_SZ;
+            if (!p->count) {
+                s_a = getEnrollStats(c, pair_keys[k][0], p->IDs[0], FALSE);
+                s_b = getEnrollStats(c, pair_keys[k][1] ? pair_keys[k][1] : LST_SUBJECT, p->IDs[1], FALSE);
+                s_a->tallies[pair_keys[k][1]]++;
+                s_b->tallies[pair_keys[k][0]]++;
+            }
+            p->count += part->pairs[i].count;
         }
     }
-    return list;
+
+    c->grade_cnt += part->grade_cnt;
+    c->grade_sum += part->grade_sum;
+
+    return TRUE;
 }
 
-void* initDataList(int lst_type)    //NOTE: references global application data list resources
+int rebuildEnrollStats()   // re-synchronizes the enrollment stats cache with the (subject-indexed) active enrollments
 {
-    int*  list_sz_ptr = getDataListSzPtr(lst_type);
-    void* list        = getDataList(lst_type);
+    Enrollment* enrolls = getDataList(LST_ENROLL);
+    int enrolls_sz      = getEnrollListSz();
+    int live_cnt        = 0;
+    int thrd_cnt;
+    StatsCache* c       = &EnrollStats;
+
+    c->valid_flg = FALSE;
+
+    if (!getEnrollIndex(LST_SUBJECT)->capacity) {   // stats are tallied as entries are linked into the subject index
+        return FALSE;
+    }
+
+    if (c->stats) memset(c->stats, 0, c->stats_cap * sizeof(Stats));
+    if (c->pairs) memset(c->pairs, 0, c->pairs_cap * sizeof(StatsPair));
+
+    c->stats_cnt = c->pairs_cnt = c->grade_cnt = 0;
+    c->grade_sum = 0;
+
+    if (enrolls)
+    for (int i = 0; i < enrolls_sz; i++) {
+        live_cnt += !enrolls[i].entry.deleted_flg;
+    }
+
+    if (!reserveEnrollStats(c, live_cnt * 3, live_cnt * 3)) {
+        return FALSE;
+    }
+    c->valid_flg = TRUE;
+
+    thrd_cnt = live_cnt / PAR_MIN_SZ;
+    if (thrd_cnt > cpuCount())   thrd_cnt = cpuCount();
+    if (thrd_cnt > PAR_MAX_THRDS) thrd_cnt = PAR_MAX_THRDS;
 
-    if  (list_sz_ptr && !list) 
+    StatsPart* parts = thrd_cnt > 1 ? calloc(thrd_cnt, sizeof(StatsPart)) : NULL;
+    PTask* tasks     = parts ? calloc(thrd_cnt, sizeof(PTask)) : NULL;
+
+    if (tasks)   // large lists are partitioned across worker threads, whose partial stats are then merged
     {
-        switch (lst_type) {
-            case LST_ENROLL:
-                return Enrollments = calloc(DAT_MIN_SZ, ENROLL_SZ);
-            case LST_SUBJECT:
-                return Subjects = calloc(DAT_MIN_SZ, SUBJECT_SZ);  
-            case USR_STUDENT:
-                return Students = calloc(DAT_MIN_SZ, USER_SZ);
-            case USR_TEACHER:
-                return Teachers = calloc(DAT_MIN_SZ, USER_SZ);  
-             case USR_PRINCIPAL:
-                return Principal = calloc(DAT_MIN_SZ, USER_SZ);   
+        for (int t = 0; t < thrd_cnt; t++) {
+            parts[t].from = (int) ((long long) enrolls_sz * t / thrd_cnt);
+            parts[t].to   = (int) ((long long) enrolls_sz * (t + 1) / thrd_cnt);
+            tasks[t].fn   = tallyEnrollRange;
+            tasks[t].arg  = parts + t;
+        }
+        runParallel(tasks, thrd_cnt);
+
+        for (int t = 0; t < thrd_cnt; t++) {
+            c->valid_flg = c->valid_flg && mergeEnrollStats(c, &parts[t].cache);
+            free(parts[t].cache.stats);
+            free(parts[t].cache.pairs);
+        }
+    }
+    else if (enrolls)
+    for (int i = 0; i < enrolls_sz; i++) {
+        if (!enrolls[i].entry.deleted_flg) {
+            tallyEnrollEntry(c, enrolls + i, 1);
         }
     }
-    return list; 
+    free(parts);
+    free(tasks);
+
+    return c->valid_flg;
 }
 
-User* initUser(User *usr, int usr_type, int loginID) 
+int fitEnrollStore(ColStore *cols, int size)  // ensures the column store can hold the given no. of slots
 {
-    if (usr && loginID > 0) {    
-        int tm_out;
-        switch (usr_type) {
-            case USR_STUDENT:
-                tm_out = TM_DEF_STUDENT;
-                break;
-            case USR_TEACHER:
-                tm_out = TM_DEF_TEACHER;
-                break;
-            case USR_PRINCIPAL:
-                tm_out = TM_DEF_PRINCIPAL;
-                break;
-            default:
-                return NULL;
-        }
+    int capacity = size + size / DAT_EXT_DIV;   // leaves room for the list to grow
+    int ok_flg;
 
-       *usr = DEF_USER;  // resets entity to a freshly initialized user
-        usr -> entry.ID = loginID;
-        usr -> timeout  = tm_out;
-        usr -> entry.deleted_flg = FALSE; 
+    if (size <= cols->capacity && cols->grades) {
+        return TRUE;
+    }
+    capacity = capacity < IDX_MIN_SZ ? IDX_MIN_SZ : capacity;
 
-        return usr;
+    float* grades = realloc(cols->grades, capacity * sizeof(float));
+
+    if (grades) cols->grades = grades;
+    ok_flg = grades != NULL;
+
+    for (int k = 0; ok_flg && k <= USR_TEACHER; k++) {
+        int* keys = realloc(cols->keys[k], capacity * sizeof(int));
+
+        if (keys) cols->keys[k] = keys;
+        else      ok_flg = FALSE;
     }
-    return NULL;
+    if (!ok_flg) {   // scans revert to the enrollment list
+        cols->capacity = cols->size = 0;
+        cols->valid_flg = FALSE;
+        return FALSE;
+    }
+    cols->capacity = capacity;
+
+    return TRUE;
 }
 
-Enrollment* initEnroll(Enrollment *enroll, int subjID, int studID, int tchrID) 
+void storeEnrollEntry(Enrollment *e)  // updates the column store row of an indexed enrollment
 {
-    if (enroll && subjID > 0 && studID > 0 && tchrID > 0) 
-    {
-       *enroll = DEF_ENROLL;  // resets entity to a freshly initialized enrollment
-        enroll -> entry.ID  = subjID;
-        enroll -> studentID = studID;
-        enroll -> teacherID = tchrID;
-        enroll -> grade     = -1;
-        enroll -> entry.deleted_flg = FALSE;
+    ColStore* cols = &EnrollStore;
+    int i = e->entry.index;
 
-        return enroll;
+    if (!(cols->valid_flg && fitEnrollStore(cols, i + 1))) {
+        return;
     }
-    return NULL;
+    if (cols->size <= i) {   // the slots between the held ones and this one are deleted
+        cols->size = i + 1;
+    }
+
+    cols->keys[0][i]           = e->entry.ID;
+    cols->keys[USR_STUDENT][i] = e->studentID;
+    cols->keys[USR_TEACHER][i] = e->teacherID;
+    cols->grades[i]            = e->grade;
 }
 
-Subject* initSubject(Subject *subj, int ID, const char* title) 
+int loadEnrollStore()   // re-synchronizes the column store with the (subject-indexed) active enrollments
 {
-    if (subj && ID > 0 && !isEmptyStr(title, TRUE, NULL)) 
-    {
-       *subj = DEF_SUBJECT;  // resets entity to a freshly initialized subject
-        subj -> entry.ID = ID;
-        strcpy(subj->title, title);
-        subj -> entry.deleted_flg = FALSE;
+    ColStore* cols      = &EnrollStore;
+    Enrollment* enrolls = getDataList(LST_ENROLL);
+    int enrolls_sz      = enrolls ? getEnrollListSz() : 0;
 
-        return subj;
+    cols->size = 0;
+    cols->valid_flg = FALSE;
+
+    if (!getEnrollIndex(LST_SUBJECT)->capacity || !fitEnrollStore(cols, enrolls_sz)) {   // rows are maintained as entries are linked into the subject index
+        return FALSE;
     }
-    return NULL;
-}
+    cols->valid_flg = TRUE;
 
-int isValidEntry(Entry* entry) {
-    return entry && !entry->deleted_flg && entry->ID > 0;
+    for (int i = 0; i < enrolls_sz; i++) {
+        storeEnrollEntry(enrolls + i);
+    }
+    return cols->valid_flg;
 }
 
-int isValidEnroll(Enrollment* enroll) {
-    return isValidEntry(enroll) && enroll->studentID > 0 && enroll->teacherID > 0;
+ColStore* getEnrollStore() {   // NULL if the column store (or the deleted bitmap it is scanned with) is unavailable
+    return EnrollStore.valid_flg && getTombMap(LST_ENROLL)->valid_flg ? &EnrollStore : NULL;
 }
 
-int isValidSubject(Subject* subj) {
-    return isValidEntry(subj) && !isEmptyStr(subj->title, TRUE, NULL);
+int seekEnrollRow(ColStore *cols, int offset, int subjID, int studID, int tchrID)  // gets the index of the first active row matching the given (+ve) keys, at or after offset
+{
+    for (int i = nextLiveEntry(LST_ENROLL, offset, cols->size); i >= 0; i = nextLiveEntry(LST_ENROLL, i + 1, cols->size)) {
+        if ((subjID <= 0 || cols->keys[0][i] == subjID) && (studID <= 0 || cols->keys[USR_STUDENT][i] == studID) && (tchrID <= 0 || cols->keys[USR_TEACHER][i] == tchrID)) {
+            return i;
+        }
+    }
+    return -1;
 }
 
-int isEntryType(int lst_type) {      // determies if lst_type is a valid global, application-defined list entry type
-    return lst_type == LST_ENROLL || isSnglEntryType(lst_type);
-}
+void aggrGrade(GradeAggr *aggr, float grade) {
+    int band = (int) (grade / 10);
 
-int isSnglEntryType(int lst_type) {  // determies if lst_type is a valid single-ID list entry type
-    return lst_type == LST_SUBJECT || isUsrType(lst_type);
+    aggr->hist[band < GRADE_HIST_SZ ? band : GRADE_HIST_SZ - 1]++;
 }
 
-int isUsrType(int lst_type) {
-    switch (lst_type) {
-        case USR_STUDENT:
-        case USR_TEACHER:
-        case USR_PRINCIPAL:
-            return TRUE;
-        default:
-            return !lst_type;   // current user type
-    }
-}
+void aggrGrades(const float *grades, const unsigned int *deleted, const int *keys, int key, int n, GradeAggr *aggr)  // aggregates the grades (>= 0) of the active rows with a matching key (all rows if keys is NULL)
+{
+    float vmin = 1e30f, vmax = -1e30f;
+    int i = 0, bits;
 
-void* getEntry(int lst_type, void* list, int index) {
-    return setEntry(lst_type, list, index, NULL);
-}
+    memset(aggr, 0, sizeof(GradeAggr));
 
-void* setEntry(int lst_type, void* list, int index, void* entry) 
-{   // when lst_type is -ve, given list is not treated as a global data list
-    // i.e. global is not used if list is NULL and index is not checked for global list size exceed violation
+#if defined(__AVX2__)   // 8 rows per iteration
+    __m256  zero = _mm256_setzero_ps(), lo = _mm256_set1_ps(1e30f), hi = _mm256_set1_ps(-1e30f);
+    __m256  g, m;
+    __m256i vkey = _mm256_set1_epi32(key), vsel = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128), live;
+    __m256d sum0 = _mm256_setzero_pd(), sum1 = _mm256_setzero_pd();
 
-    if (index < 0)
-        return NULL;    
-                                
-    if (lst_type < 0) {           
-        lst_type = abs(lst_type);
-    } 
-    else if (index >= getDataListSz(lst_type, FALSE)) {
-        return NULL;
-    } 
-    else if (!list) {
-        list = getDataList(lst_type);
-    }
+    for (; i + 8 <= n; i += 8) {
+        if (!(bits = ~deleted[i >> 5] >> (i & 31) & 0xFF))
+            continue;
 
-    if (!list)
-        return NULL;
+        live = _mm256_and_si256(_mm256_set1_epi32(bits), vsel);
+        g = _mm256_loadu_ps(grades + i);
+        m = _mm256_and_ps(_mm256_cmp_ps(g, zero, _CMP_GE_OQ), _mm256_castsi256_ps(_mm256_cmpeq_epi32(live, vsel)));
+        if (keys) {
+            m = _mm256_and_ps(m, _mm256_castsi256_ps(_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*) (keys + i)), vkey)));
+        }
+        if (!(bits = _mm256_movemask_ps(m))) 
+            continue;
 
-    void* lst_entry;
-    int entry_flg = TRUE;
+        lo = _mm256_min_ps(lo, _mm256_blendv_ps(lo, g, m));
+        hi = _mm256_max_ps(hi, _mm256_blendv_ps(hi, g, m));
+        g  = _mm256_and_ps(g, m);
+        sum0 = _mm256_add_pd(sum0, _mm256_cvtps_pd(_mm256_castps256_ps128(g)));
+        sum1 = _mm256_add_pd(sum1, _mm256_cvtps_pd(_mm256_extractf128_ps(g, 1)));
+        aggr->count += __builtin_popcount(bits);
+
+        for (; bits; bits &= bits - 1) {
+            aggrGrade(aggr, grades[i + __builtin_ctz(bits)]);
+        }
+    }
+    double sums [4];
+    float  lane [8];
+
+    _mm256_storeu_pd(sums, _mm256_add_pd(sum0, sum1));
+    aggr->sum = sums[0] + sums[1] + sums[2] + sums[3];
+    _mm256_storeu_ps(lane, lo);
+    for (int l = 0; l < 8; l++) if (lane[l] < vmin) vmin = lane[l];
+    _mm256_storeu_ps(lane, hi);
+    for (int l = 0; l < 8; l++) if (lane[l] > vmax) vmax = lane[l];
+
+#elif defined(__SSE2__)   // 4 rows per iteration
+    __m128  zero = _mm_setzero_ps(), lo = _mm_set1_ps(1e30f), hi = _mm_set1_ps(-1e30f);
+    __m128  g, m;
+    __m128i vkey = _mm_set1_epi32(key), vsel = _mm_setr_epi32(1, 2, 4, 8), live;
+    __m128d sum0 = _mm_setzero_pd(), sum1 = _mm_setzero_pd();
+
+    for (; i + 4 <= n; i += 4) {
+        if (!(bits = ~deleted[i >> 5] >> (i & 31) & 0xF))
+            continue;
 
+        live = _mm_and_si128(_mm_set1_epi32(bits), vsel);
+        g = _mm_loadu_ps(grades + i);
+        m = _mm_and_ps(_mm_cmpge_ps(g, zero), _mm_castsi128_ps(_mm_cmpeq_epi32(live, vsel)));
+        if (keys) {
+            m = _mm_and_ps(m, _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*) (keys + i)), vkey)));
+        }
+        if (!(bits = _mm_movemask_ps(m))) 
+            continue;
 
-    if (lst_type == LST_PTR) 
-    {
-        entry_flg = FALSE;
-        lst_entry = (void**) list + index;
-        *(void**) lst_entry = entry;
+        lo = _mm_min_ps(lo, _mm_or_ps(_mm_and_ps(m, g), _mm_andnot_ps(m, lo)));
+        hi = _mm_max_ps(hi, _mm_or_ps(_mm_and_ps(m, g), _mm_andnot_ps(m, hi)));
+        g  = _mm_and_ps(g, m);
+        sum0 = _mm_add_pd(sum0, _mm_cvtps_pd(g));
+        sum1 = _mm_add_pd(sum1, _mm_cvtps_pd(_mm_movehl_ps(g, g)));
+        aggr->count += __builtin_popcount(bits);
+
+        for (; bits; bits &= bits - 1) {
+            aggrGrade(aggr, grades[i + __builtin_ctz(bits)]);
+        }
     }
-    else
-    if (lst_type == LST_ENROLL) 
-    {
-        lst_entry = (Enrollment*) list + index;
-        if (entry)
-          *(Enrollment*) lst_entry = *(Enrollment*) entry;
+    double sums [2];
+    float  lane [4];
+
+    _mm_storeu_pd(sums, _mm_add_pd(sum0, sum1));
+    aggr->sum = sums[0] + sums[1];
+    _mm_storeu_ps(lane, lo);
+    for (int l = 0; l < 4; l++) if (lane[l] < vmin) vmin = lane[l];
+    _mm_storeu_ps(lane, hi);
+    for (int l = 0; l < 4; l++) if (lane[l] > vmax) vmax = lane[l];
+#endif
+
+    for (; i < n; i++) {   // remaining rows (or all of them, without SIMD support)
+        if (grades[i] >= 0 && !(deleted[i >> 5] >> (i & 31) & 1) && (!keys || keys[i] == key)) {
+            aggr->sum += grades[i];
+            aggr->count++;
+            if (grades[i] < vmin) vmin = grades[i];
+            if (grades[i] > vmax) vmax = grades[i];
+            aggrGrade(aggr, grades[i]);
+        }
     }
-    else
-    if (lst_type == LST_SUBJECT) 
-    {
-        lst_entry = (Subject*) list + index;
-        if (entry)
-          *(Subject*) lst_entry = *(Subject*) entry;
-    }    
-    else
-    if (isUsrType(lst_type))
-    {
-        lst_entry = (User*) list + index;
-        if (entry)
-          *(User*) lst_entry = *(User*) entry;
+
+    aggr->min = aggr->count ? vmin : -1;
+    aggr->max = aggr->count ? vmax : -1;
+}
+
+int reportGrades(int entryID, int usr_type, GradeAggr *aggr)  // aggregates the grades of an entity's active enrollments (the whole school if entryID <= 0)
+{
+    ColStore* cols = getEnrollStore();
+    TombMap*  tm   = getTombMap(LST_ENROLL);
+
+    if (!(cols && tm->valid_flg && tm->capacity >= cols->size)) {
+        return FALSE;   // the rows cannot be told apart from the deleted ones; reverts to an index scan
     }
-    else
-    {
-        entry_flg = FALSE;
+    aggrGrades(cols->grades, tm->deleted, entryID > 0 ? cols->keys[getEnrollKeyType(usr_type)] : NULL, entryID, cols->size, aggr);
+
+    return TRUE;
+}
+
+int rebuildEnrollIndexes()   // re-synchronizes the enrollment key indexes with the global enrollment list
+{
+    Enrollment* enrolls = getDataList(LST_ENROLL);
+    int enrolls_sz      = getEnrollListSz();
+    int capacity        = IDX_MIN_SZ;
+    int usr_types []    = {LST_SUBJECT, USR_STUDENT, USR_TEACHER};
+    MultiIndex* idx;
+
+    while (capacity < enrolls_sz) {
+        capacity *= 2;
     }
 
-    if (entry && entry_flg) {
-        ((Entry*) lst_entry)->index = index;
+    for (int k = 0; k < 3; k++) 
+    {
+        idx = getEnrollIndex(usr_types[k]);
+
+        if (idx->capacity < capacity)
+        {
+            int* heads = realloc(idx->heads, capacity * sizeof(int));
+            int* links = heads? realloc(idx->links, capacity * sizeof(int)): NULL;
+
+            if (heads) idx->heads = heads;
+            if (links) idx->links = links;
+
+            if (!(heads && links)) {   // disable the index; searches revert to list scans
+                idx->buckets = idx->capacity = 0;
+                continue;
+            }
+            idx->buckets = idx->capacity = capacity;
+        }
+
+        memset(idx->heads, 0, idx->buckets * sizeof(int));
+        memset(idx->links, 0, idx->capacity * sizeof(int));
+
+        // chains are built backwards so that each one is in ascending entry order
+        if (enrolls)
+        for (int i = enrolls_sz - 1; i >= 0; i--) {
+            if (!enrolls[i].entry.deleted_flg) {
+                int* head = idx->heads + hashSlot(getEnrollKey(usr_types[k], enrolls + i), idx->buckets);
+
+                idx->links[i] = *head;
+                *head = i + 1;
+            }
+        }
     }
+    rebuildEnrollStats();
+    loadEnrollStore();
 
-    return lst_entry;
+    return TRUE;
 }
 
-Entry* addListEntry(int lst_type, void *entry) {
-    // handle null reference
-    if (!(entry && isEntryType(lst_type))) {
-        return entry;
+int indexEnrollEntry(int lst_type, Enrollment *e) 
+{
+    int usr_types [] = {LST_SUBJECT, USR_STUDENT, USR_TEACHER};
+    MultiIndex* idx;
+
+    (void) lst_type;
+
+    if (!e || e->entry.deleted_flg) {
+        return FALSE;
     }
 
-    // handle invalid data list type
-    void*list = getDataList(lst_type);
-    if (!list) {
-        return NULL;
+    if (e->entry.index >= getEnrollIndex(LST_SUBJECT)->capacity) {  // entry already resides in the list, so the rebuild includes it
+        return rebuildEnrollIndexes();
     }
 
-    // add user to available tombstoned slot (if any)
-    int list_sz = getDataListSz(lst_type, FALSE);
-    int i; Entry* e;
-    for (i = 0; i < list_sz; i++) 
-    {    
-        e = getEntry(lst_type, list, i);
-        if (e->deleted_flg) {
-            return setEntry(lst_type, list, i, entry);
+    for (int k = 0; k < 3; k++) {
+        idx = getEnrollIndex(usr_types[k]);
+        if (idx->capacity && linkEnrollEntry(idx, getEnrollKey(usr_types[k], e), e) && !k) {
+            tallyEnrollEntry(&EnrollStats, e, 1);     // tallied once, as it is linked into the subject index
+            storeEnrollEntry(e);
         }
     }
+    return TRUE;
+}
+
+void unindexEnrollEntry(int lst_type, Enrollment *e)  // NOTE: must be invoked before any enrollment key is altered
+{
+    int usr_types [] = {LST_SUBJECT, USR_STUDENT, USR_TEACHER};
+    MultiIndex* idx;
 
-    // increase slot capacity and add user at the end
-    if (list = extDataList(lst_type)) {
-        return setEntry(lst_type, list, i, entry);
+    (void) lst_type;
+
+    if (e)
+    for (int k = 0; k < 3; k++) {
+        idx = getEnrollIndex(usr_types[k]);
+        if (e->entry.index < idx->capacity && unlinkEnrollEntry(idx, getEnrollKey(usr_types[k], e), e) && !k) {
+            tallyEnrollEntry(&EnrollStats, e, -1);
+        }
     }
+}
 
-    return NULL;
+int seekEnrollEntry(int usr_type, int key, int offset)  // gets the index of the first enrollment with the given key, at or after offset
+{
+    MultiIndex* idx = getEnrollIndex(usr_type);
+    int i = idx->buckets? idx->heads[hashSlot(key, idx->buckets)] - 1: -1;
+
+    while (i >= 0 && (i < offset || getEnrollKey(usr_type, Enrollments + i) != key)) {
+        i = idx->links[i] - 1;
+    }
+    return i;
 }
 
-void deleteListEntry(Entry *entry) {
-    if (entry) { 
-         entry->deleted_flg = TRUE;
-    } 
+int nextEnrollEntry(int usr_type, int key, int index)  // gets the index of the enrollment with the given key, following the (indexed) one at index
+{
+    MultiIndex* idx = getEnrollIndex(usr_type);
+    int i = index < 0 || index >= idx->capacity? -1: idx->links[index] - 1;
+
+    while (i >= 0 && getEnrollKey(usr_type, Enrollments + i) != key) {
+        i = idx->links[i] - 1;
+    }
+    return i;
 }
 
 Entry* getListEntry(int lst_type, int entryID, int offset)  // supports only single-ID entry list types
 {
     void* list  = getDataList(lst_type);
     int list_sz = getDataListSz(lst_type, FALSE);
+    Index* idx  = getListIndex(lst_type);
+
+    if (list && entryID > 0 && offset <= 0 && idx && idx->capacity) {   // active entry ID lookup served by the list index
+        return getEntry(lst_type, list, findListIndex(lst_type, entryID));
+    }
 
     if (list && isSnglEntryType(lst_type)) {
         Entry* e;
@@ -933,7 +2865,39 @@ Enrollment* getEnrollPtr(int entryID, int usr_type, Enrollment**list, int list_s
             return e;
         }
     }
-    return NULL;
+    return NULL;
+}
+
+int putKeySet(Index *set, int key)  // adds a non -ve key to a hash set of (key + 1) slots; returns FALSE if already present, -1 if the set cannot grow
+{
+    if ((set->count + 1) * 2 > set->capacity)   // maintain a load factor of at most 1/2
+    {
+        Index old    = *set;
+        set->capacity = old.capacity < IDX_MIN_SZ ? IDX_MIN_SZ : old.capacity * 2;
+        set->slots    = calloc(set->capacity, sizeof(int));
+        set->count    = 0;
+
+        if (!set->slots) {
+            *set = old;
+            return -1;
+        }
+        for (int i = 0; i < old.capacity; i++) {
+            if (old.slots[i])
+                putKeySet(set, old.slots[i] - 1);
+        }
+        free(old.slots);
+    }
+
+    int slot = hashSlot(key, set->capacity);
+
+    for (; set->slots[slot]; slot = (slot + 1) & (set->capacity - 1)) {
+        if (set->slots[slot] == key + 1)
+            return FALSE;
+    }
+    set->slots[slot] = key + 1;
+    set->count++;
+
+    return TRUE;
 }
 
 int enrollSearch(int entryID, int utyp_sbjID, int tgtyp_stdID, int tchrID, int offset, Enrollment**res_list, int res_limit) 
@@ -955,6 +2919,7 @@ int enrollSearch(int entryID, int utyp_sbjID, int tgtyp_stdID, int tchrID, int o
      * in the search list exceeds res_limit. In this case, the index of the next matching entry in the search list, 
      * after the last entry populated in the result list, is returned as a -ve value. 
      * The offset parameter, which also supports -ve indexing, may be used in tandem with res_limit to page search results.
+     * If res_list is NULL, matching entries are only counted (e.g. for distinct tallies) and no result list is populated.
      * 
      * WARNING: If a +ve res_list is provided, it should not exceed the actual capacity of res_list.
      */
@@ -969,31 +2934,46 @@ int enrollSearch(int entryID, int utyp_sbjID, int tgtyp_stdID, int tchrID, int o
     int studID       = tgtyp_stdID;
 
     Enrollment* e;
-    int entry_id, entry_cnt = 0;
+    int entry_id, entry_cnt = 0, result = 0, dup_flg;
+    Index tgt_ids = {NULL};   // hash set of the target IDs already matched, which enforces their non-duplication
 
     Enrollment*enrolls = getDataList(LST_ENROLL);
     int enrolls_sz     = getEnrollListSz();
 
-    if (res_limit <= 0) {
-        res_limit = enrolls_sz;
+    int key_type = LST_SUBJECT, key = 0;    // index key used to narrow the scan to matching candidates (if any)
+
+    if (!kc_srch_flg) {
+        if (entryID > 0 && getEnrollIndex(usr_type)->capacity) {
+            key_type = usr_type; key = entryID;
+        }
+    }
+    else if (studID > 0 && getEnrollIndex(USR_STUDENT)->capacity) {
+        key_type = USR_STUDENT; key = studID;
+    }
+    else if (tchrID > 0 && getEnrollIndex(USR_TEACHER)->capacity) {
+        key_type = USR_TEACHER; key = tchrID;
+    }
+    else if (subjID > 0 && getEnrollIndex(LST_SUBJECT)->capacity) {
+        key_type = LST_SUBJECT; key = subjID;
     }
 
-    if (!(res_list || kc_srch_flg)) 
-    {
-        int enrolls_cnt = getListEntryCnt(enrolls, enrolls_sz);
+    ColStore* cols = key || entryID < 0 ? NULL : getEnrollStore();   // unindexed scans of active entries filter the column store instead
+    int row_keys [USR_TEACHER + 1] = {0};
 
-        if (entryID < 0) {
-            enrolls_cnt = enrolls_sz - enrolls_cnt;
-        }
-        if (res_limit > enrolls_cnt) {
-            res_limit = enrolls_cnt;
-        }
-        if (res_limit > 1) {
-            res_list = calloc(res_limit, PTR_SZ);  //provide local buffer list 
-        }
+    if (kc_srch_flg) {
+        row_keys[0] = subjID; row_keys[USR_STUDENT] = studID; row_keys[USR_TEACHER] = tchrID;
+    } else {
+        row_keys[getEnrollKeyType(usr_type)] = entryID;
+    }
+
+    if (res_limit <= 0) {
+        res_limit = enrolls_sz;
     }
 
-    for (int i = abs(offset), match_flg = FALSE; i < enrolls_sz; i++, match_flg = FALSE) {
+    for (int i = key? seekEnrollEntry(key_type, key, abs(offset)): cols? seekEnrollRow(cols, abs(offset), row_keys[0], row_keys[USR_STUDENT], row_keys[USR_TEACHER]): abs(offset), match_flg = FALSE; 
+             i >= 0 && i < enrolls_sz; 
+             i = key? nextEnrollEntry(key_type, key, i): cols? seekEnrollRow(cols, i + 1, row_keys[0], row_keys[USR_STUDENT], row_keys[USR_TEACHER]): i + 1, match_flg = FALSE) 
+    {
         e = enrolls + i;
 
         if (kc_srch_flg) 
@@ -1009,7 +2989,19 @@ int enrollSearch(int entryID, int utyp_sbjID, int tgtyp_stdID, int tchrID, int o
                 entry_id = getEnrollEntryID(_active * tgt_usr_type, e);
 
                 // prevents duplicate addition of enrollment entries
-                if (!getEnrollPtr(_active * entry_id, tgt_usr_type, res_list, entry_cnt)) {
+                if ((dup_flg = putKeySet(&tgt_ids, entry_id)) >= 0) {
+                    dup_flg = !dup_flg;
+                }
+                else
+                {   // no memory for the set; revert to searching the matches preceding this entry
+                    int j = i - 1;
+
+                    while (j >= abs(offset) && !(entryID == getEnrollEntryID(_active * usr_type, enrolls + j) && entry_id == getEnrollEntryID(_active * tgt_usr_type, enrolls + j))) {
+                        j--;
+                    }
+                    dup_flg = j >= abs(offset);
+                }
+                if (!dup_flg) {
                     match_flg = TRUE;
                 }
             }
@@ -1017,29 +3009,35 @@ int enrollSearch(int entryID, int utyp_sbjID, int tgtyp_stdID, int tchrID, int o
 
         if (match_flg)
         if (entry_cnt < res_limit) {
-            res_list[entry_cnt++] = e;
+            if (res_list) 
+                res_list[entry_cnt] = e;
+            entry_cnt++;
 
             if (kc_srch_flg && subjID > 0 && studID > 0 && tchrID > 0)  // unique entry search short-circuit optimization
                 break;
-        } else
-            return -i;  //search results exceed specified limit
+        } else {
+            result = -i;  //search results exceed specified limit
+            break;
+        }
     }
 
-    return entry_cnt;
+    free(tgt_ids.slots);
+
+    return result? result: entry_cnt;
 }
 
 int getSubjects(int entryID, int usr_type, int* subj_buf, const int avl_subj_flg)  // gets enrolled/available subjects for user
 {  
     int subj_total = 0;
     int subjects_sz = getSubjectListSz();
+    SMark mark = scratchMark();
 
     if (subjects_sz) {
         int total = 0;
         int enrolls_sz  = getEnrollListSz();
         Enrollment** enrolls_ptr;
 
-        if (enrolls_sz) {
-            enrolls_ptr = malloc(subjects_sz * PTR_SZ);
+        if (enrolls_sz && (enrolls_ptr = scratchAlloc(subjects_sz * PTR_SZ))) {
             total = enrollSearch(entryID, usr_type, NULL, -1, 0, enrolls_ptr, subjects_sz); 
         }
 
@@ -1069,33 +3067,65 @@ int getSubjects(int entryID, int usr_type, int* subj_buf, const int avl_subj_flg
             }
         }
     }
+    scratchRelease(mark);
 
     return subj_total;
 }
 
 int calculateTally(int entryID, int usr_type, int tgt_usr_type) {
+    Stats* s;
+
+    if (entryID > 0 && EnrollStats.valid_flg) {    // served by the stats cache; deleted entry tallies are still searched
+        s = getEnrollStats(&EnrollStats, usr_type, entryID, FALSE);
+        return s? s->tallies[getEnrollKeyType(tgt_usr_type)]: 0;
+    }
     return enrollSearch(entryID, usr_type, tgt_usr_type, -1, 0, NULL, 0);
 }
 
-float calculateAvgGrade(int entryID, int usr_type) {
-    float sum = 0;
-    int count = 0;
+int calculateGradeAggr(int entryID, int usr_type, GradeAggr *aggr)   // aggregates the grades (incl. min, max & histogram) of an entity's enrollments (the whole school if entryID <= 0); returns the no. of grades
+{
     Enrollment* e;
 
+    // school and subject grades are aggregated over the column store; user grades via the key indexes
+    if ((entryID <= 0 || getEnrollKeyType(usr_type) == 0) && reportGrades(entryID, usr_type, aggr)) {
+        return aggr->count;
+    }
+    memset(aggr, 0, sizeof(GradeAggr));
+    aggr->min = aggr->max = -1;
+
     Enrollment* enrolls = getDataList(LST_ENROLL);
     int enrolls_sz      = getEnrollListSz();
+    int key             = entryID > 0 && getEnrollIndex(usr_type)->capacity ? entryID : 0;
 
-    for (int i=0; i < enrolls_sz; i++) {
+    for (int i = key? seekEnrollEntry(usr_type, key, 0): 0; i >= 0 && i < enrolls_sz; i = key? nextEnrollEntry(usr_type, key, i): i + 1) {
         e = enrolls + i;
         
         if (!e->entry.deleted_flg && e->grade >= 0 && (entryID <= 0 || entryID == getEnrollEntryID(usr_type, e))) {
-            sum += e->grade;
-            count++;
+            if (!aggr->count || e->grade < aggr->min) aggr->min = e->grade;
+            if (!aggr->count || e->grade > aggr->max) aggr->max = e->grade;
+            aggr->sum += e->grade;
+            aggr->count++;
+            aggrGrade(aggr, e->grade);
         }
     }
+    return aggr->count;
+}
+
+float calculateAvgGrade(int entryID, int usr_type) {
+    Stats* s;
+    GradeAggr aggr;
+
+    if (EnrollStats.valid_flg) {   // served by the stats cache
+        s = entryID > 0 ? getEnrollStats(&EnrollStats, usr_type, entryID, FALSE) : NULL;
+
+        if (entryID > 0 ? s && s->grade_cnt > 0 : EnrollStats.grade_cnt > 0)
+            return entryID > 0 ? s->grade_sum / s->grade_cnt : EnrollStats.grade_sum / EnrollStats.grade_cnt;
+        else
+            return -1;
+    }
 
-    if (count > 0)
-        return sum / count;
+    if (calculateGradeAggr(entryID, usr_type, &aggr) > 0)
+        return aggr.sum / aggr.count;
     else
         return -1;
 }
@@ -1112,8 +3142,7 @@ int calculateAge(Date* tm_dob, const char* str_dob) {
     }
 
     //get current time
-    time_t t = time(NULL);
-    struct tm *tm_cur = localtime(&t);
+    struct tm *tm_cur = clockTm();
     
     //calculate Age
     int age = tm_cur->tm_year - tm_dob->tm_year;
@@ -1139,9 +3168,11 @@ int convertDate(const char* dstr, Date* dptr) {  // Gregarian-based validation d
 
     //copy date to editable string
     int str_len = strlen(dstr);
-    char* dt = malloc((str_len + 1) *CHAR_SZ);
+    char* dt = scratchAlloc((str_len + 1) *CHAR_SZ);   // released along with the scratch of the calling screen
     char c;
 
+    if (!dt) return FALSE;
+
     for (int i=0; i < str_len; i++) {
         c = dstr[i];
         if (!(isdigit(c) || c == '/') )
@@ -1188,8 +3219,7 @@ int convertDate(const char* dstr, Date* dptr) {  // Gregarian-based validation d
     
     if (dptr) {
         //use local time settings to properly initialize date
-        time_t curr_tm = time(NULL);
-        *dptr = *localtime(&curr_tm);
+       *dptr = *clockTm();
 
         dptr->tm_mday = dy;
         dptr->tm_mon  = mn - 1;
@@ -1247,6 +3277,51 @@ int print6ColTblHdr(const char* col_txt1, int col_sz1, const char* col_txt2, int
     return printScrHeader (col_txt1, col_sz1, col_txt2, col_sz2, col_txt3, col_sz3, col_txt4, col_sz4, col_txt5, col_sz5, col_txt6, col_sz6, "=", -1);
 }
 
+int getPageSz() {   // no. of table rows shown per page, fitted to the console height (if known)
+    int cols, rows = scrDims(&cols);
+    int page_sz = rows > 0 ? rows - PAGE_HDR_SZ : SCR_SIZE / PAGE_ROW_DIV;
+
+    return page_sz < PAGE_MIN_SZ ? PAGE_MIN_SZ : page_sz;
+}
+
+int getPageCnt(int row_cnt, int page_sz, int* page_ptr) {   // also brings the given page within range
+    int page_cnt = row_cnt > 0 ? (row_cnt + page_sz - 1) / page_sz : 1;
+
+    if (*page_ptr >= page_cnt) {
+        *page_ptr = page_cnt - 1;
+    }
+    return page_cnt;
+}
+
+void printPageFtr(int page, int page_cnt, int margin) {
+    if (page_cnt > 1) {
+        printScrf ("\n");
+        printScrHMargin(margin);
+        printScrf ("Page %d of %d  ([N] Next page, [P] Previous page)\n", page + 1, page_cnt);
+    }
+}
+
+int promptPageOpt(const char* msg, int* choice, int* page_ptr, int page_cnt) {  // reads an item no. or a page option; returns -1 if the page was changed
+    char input [ITEM_NO_SZ + 2];
+    int  opt;
+
+    promptLn(msg, input, ITEM_NO_SZ + 1);
+    trim(input, -1, NULL, FTRIM);
+
+    opt = toupper(*input);
+
+    if (page_cnt > 1 && (opt == 'N' || opt == 'P') && !input[1]) {
+       *page_ptr = (*page_ptr + (opt == 'N' ? 1 : page_cnt - 1)) % page_cnt;   // pages wrap around
+        return -1;
+    }
+
+    if (choice) {
+       *choice = isDigitStr(input, FALSE, FALSE) ? atoi(input) : 0;
+        return *choice > 0;
+    }
+    return FALSE;
+}
+
 printGrade(float grade, const char* pst_txt) 
 {
     if(grade < 0) {
@@ -1255,7 +3330,7 @@ printGrade(float grade, const char* pst_txt)
         printScrColVal(grade, 0, 1, NULL);
     }
     if (pst_txt) {
-        printf(pst_txt); 
+        printScrf(pst_txt); 
     }
 }
 
@@ -1467,7 +3542,7 @@ int submitEnrollData(Enrollment *enroll_buf, int enroll_cnt, const int auth_mode
 
         if (!fwptr) return -1;  // abort mod session
 
-        int edt_err_flg, edt_err_cnt = 0;
+        int edt_err_flg, edt_err_cnt = 0, e_idx;
         char entry_key [12];
         Enrollment *e, *enrolls_ptr [1];
 
@@ -1480,7 +3555,12 @@ int submitEnrollData(Enrollment *enroll_buf, int enroll_cnt, const int auth_mode
             if (edit_mode_flg) 
             {
                 if (enrollSearch(NULL, e->entry.ID, e->studentID, e->teacherID, 0, enrolls_ptr, 1)) {
-                    **enrolls_ptr = *e; edt_err_flg = FALSE;
+                    e_idx = (*enrolls_ptr)->entry.index;
+
+                    unindexListEntry(LST_ENROLL, (Entry*) *enrolls_ptr);   // re-key the updated entry
+                    setEntry(LST_ENROLL, NULL, e_idx, e);
+                    indexListEntry(LST_ENROLL, (Entry*) *enrolls_ptr); 
+                    edt_err_flg = FALSE;
                 }
             } 
             else 
@@ -1493,12 +3573,14 @@ int submitEnrollData(Enrollment *enroll_buf, int enroll_cnt, const int auth_mode
                 strcat(entry_key, "+");
                 strcat(entry_key, e->studentID);
 
+                scrLogTag(LST_ENROLL, e->entry.ID, 0);
                 warn (edit_mode_flg? 
                       NO_ENTRY_ERROR:REG_ENTRY_ERROR, 
                       entry_key, 
                       edit_mode_flg? 
                       "The enrollment may have been altered from an external source.":"An unknown application error has occurred.", 
                       FALSE);
+                scrLogTag(0, 0, 0);
             } 
         }
 
@@ -1511,32 +3593,224 @@ int submitEnrollData(Enrollment *enroll_buf, int enroll_cnt, const int auth_mode
     return enroll_cnt < 0 ? 0 : enroll_cnt;
 }
 
+int parseLoginID(char *fld) {   // converts a CSV login ID field into a (hashed) login ID; returns 0 if invalid
+    int loginID = isDigitStr(fld, FALSE, FALSE) && strlen(fld) <= PASSCODE_SZ ? atoi(fld): 0;
+
+    return (PASSCODE_MN <= loginID && loginID <= PASSCODE_MX)? hashID(loginID): 0;
+}
+
+char *parseUserRecord(char **flds, int fld_cnt, int usr_type, User *usr)   // validates a user import record as per the profile registration rules; returns the reason for rejection (if any)
+{
+    int  loginID = fld_cnt > 0 ? parseLoginID(flds[0]): 0;
+    Date tm;
+
+    if (fld_cnt < 5 || fld_cnt > 6)
+        return "Expected 5 or 6 fields.";
+    if (!loginID)
+        return "The login ID is invalid.";
+    if (getUser(loginID, usr_type))
+        return "The login ID is already taken.";
+    if (!*flds[1] || strlen(flds[1]) > FNAME_SZ)
+        return "The first name is blank or too long.";
+    if (strlen(flds[2]) > LNAME_SZ)
+        return "The last name is too long.";
+    if (strlen(flds[3]) > ADDR_SZ)
+        return "The address is too long.";
+    if (strlen(flds[4]) > DOB_SZ || !convertDate(flds[4], &tm) || tm.tm_year < 0 || calculateAge(&tm, NULL) < 0)
+        return "The date of birth is invalid.";
+    if (fld_cnt > 5 && *flds[5] && !(isDigitStr(flds[5], FALSE, FALSE) && strlen(flds[5]) <= TOUT_SZ && atoi(flds[5]) > 0))
+        return "The session timeout is invalid.";
+
+    initUser(usr, usr_type, loginID);
+    strcpy(usr->Fname, flds[1]);
+    strcpy(usr->Lname, flds[2]);
+    strcpy(usr->Addr,  flds[3]);
+    strcpy(usr->Dob,   flds[4]);
+
+    if (fld_cnt > 5 && *flds[5]) {
+        usr->timeout = atoi(flds[5]);
+    }
+    usr->reg_stat = usr_type == USR_STUDENT? REG_STAT_SUBJ: REG_STAT_FULL;   // imported students have yet to register their subjects
+
+    return NULL;
+}
+
+char *parseEnrollRecord(char **flds, int fld_cnt, Enrollment *enroll)   // validates an enrollment import record as per the subject registration rules; returns the reason for rejection (if any)
+{
+    int subjID = fld_cnt > 0 && isDigitStr(flds[0], FALSE, FALSE) && strlen(flds[0]) < 10 ? atoi(flds[0]): 0;
+    int studID = fld_cnt > 1 ? parseLoginID(flds[1]): 0;
+    int tchrID = fld_cnt > 2 ? parseLoginID(flds[2]): 0;
+    Enrollment *enrolls_ptr [1];
+
+    if (fld_cnt < 3 || fld_cnt > 4)
+        return "Expected 3 or 4 fields.";
+    if (!getSubject(subjID))
+        return "The subject does not exist.";
+    if (!getUser(studID, USR_STUDENT))
+        return "The student does not exist.";
+    if (!getUser(tchrID, USR_TEACHER))
+        return "The teacher does not exist.";
+    if (enrollSearch(0, subjID, studID, 0, 0, enrolls_ptr, 1))
+        return "The student is already enrolled in the subject.";
+    if (fld_cnt > 3 && *flds[3] && !(isDigitStr(flds[3], FALSE, TRUE) && atof(flds[3]) >= 0))
+        return "The grade is invalid.";
+
+    initEnroll(enroll, subjID, studID, tchrID);
+
+    if (fld_cnt > 3 && *flds[3]) {
+        enroll->grade = atof(flds[3]);
+    }
+    return NULL;
+}
+
+char *readImportRecord(FILE *fptr, int *rec_no_ptr, char **flds, int *fld_cnt_ptr, char **reason_ptr)   // reads the next non-blank CSV import record, skipping a leading header record
+{
+    static char line [CSV_LN_SZ + 2];
+    int c;
+
+    while (fgets(line, sizeof(line), fptr)) 
+    {
+        (*rec_no_ptr)++;
+        *reason_ptr = NULL;
+
+        if (!strchr(line, '\n') && !feof(fptr)) 
+        {  // the rest of an over-long record is skipped, so that it is rejected once rather than parsed in pieces
+            while ((c = fgetc(fptr)) != EOF && c != '\n');
+
+            *fld_cnt_ptr = 0;
+            *reason_ptr  = "The record is too long.";
+            return line;
+        }
+        *fld_cnt_ptr = splitCSV(line, flds, CSV_FLD_MAX);
+
+        for (int i = 0; i < *fld_cnt_ptr; i++) {
+            trim(flds[i], -1, NULL, FTRIM);
+        }
+        if (*fld_cnt_ptr == 1 && !*flds[0])
+            continue;   // blank record
+        if (*rec_no_ptr == 1 && !isDigitStr(flds[0], FALSE, FALSE))
+            continue;   // header record
+
+        return line;
+    }
+    return NULL;
+}
+
+void rejectImportRecord(int lst_type, int rec_no, char *reason, int *rej_cnt_ptr) {  // rejected import records are only logged to file, since there may be many
+    char msg [SCR_SIZE];
+
+    sprintf(msg, "Import record #%d was rejected: %s", rec_no, reason);
+    scrLogRec(LVL_WARN, lst_type, 0, rec_no, msg);
+    (*rej_cnt_ptr)++;
+}
+
+int importUserData(int usr_type, FILE *fptr, int *rej_cnt_ptr)   // registers the users of a CSV file in a single save session; returns the no. of users imported, -1 upon failure
+{
+    char *flds [CSV_FLD_MAX], *reason;
+    int   fld_cnt, rec_no = 0, imp_cnt = 0;
+    User  usr;
+
+    FILE* fwptr = refreshData(usr_type, READ_WRITE, SECURED);  // begin mod session 
+
+    if (!fwptr) return -1;  // abort mod session
+
+    SMark mark = scratchMark();
+
+    while (readImportRecord(fptr, &rec_no, flds, &fld_cnt, &reason)) 
+    {
+        scratchRelease(mark);   // e.g. dates parsed from the previous record
+
+        if (reason || (reason = parseUserRecord(flds, fld_cnt, usr_type, &usr))) {
+            rejectImportRecord(usr_type, rec_no, reason, rej_cnt_ptr);
+        } 
+        else if (!addListEntry(usr_type, &usr)) {
+            rejectImportRecord(usr_type, rec_no, "An unknown application error has occurred.", rej_cnt_ptr);
+        } 
+        else imp_cnt++;
+    }
+
+    if (!persistData(usr_type, fwptr))  // end mod session
+        return -1;
+
+    return imp_cnt;
+}
+
+int importEnrollData(FILE *fptr, int *rej_cnt_ptr)   // registers the enrollments of a CSV file in a single save session; returns the no. of enrollments imported, -1 upon failure
+{
+    char *flds [CSV_FLD_MAX], *reason;
+    int   fld_cnt, rec_no = 0, imp_cnt = 0;
+    Enrollment enroll;
+    User* stud;
+    FILE *fwptr, *efwptr;
+
+    if (!(refreshData(LST_SUBJECT, READ_ONLY, SECURED) && refreshData(USR_TEACHER, READ_ONLY, SECURED)))
+        return -1;
+
+    // the student list is staged first, as per the order in which save sessions are nested elsewhere
+    if (!(fwptr = refreshData(USR_STUDENT, READ_WRITE, SECURED)))   // begin student mod session 
+        return -1;
+
+    if (!(efwptr = refreshData(LST_ENROLL, READ_WRITE, SECURED))) {   // begin enrollment mod session 
+        discardListData(getDataList(USR_STUDENT), fwptr);
+        return -1;
+    }
+
+    SMark mark = scratchMark();
+
+    while (readImportRecord(fptr, &rec_no, flds, &fld_cnt, &reason)) 
+    {
+        scratchRelease(mark);   // e.g. dates parsed from the previous record
+
+        if (reason || (reason = parseEnrollRecord(flds, fld_cnt, &enroll))) {
+            rejectImportRecord(LST_ENROLL, rec_no, reason, rej_cnt_ptr);
+        } 
+        else if (!registerEnrollment(&enroll)) {
+            rejectImportRecord(LST_ENROLL, rec_no, "An unknown application error has occurred.", rej_cnt_ptr);
+        } 
+        else {
+            if ((stud = getUser(enroll.studentID, USR_STUDENT)) && stud->reg_stat == REG_STAT_SUBJ) {
+                stud->reg_stat = REG_STAT_FULL;   // the student's registration is completed by their first enrollment
+            }
+            imp_cnt++;
+        }
+    }
+
+    if (!persistData(LST_ENROLL, efwptr)) {  // end enrollment mod session
+        discardListData(getDataList(USR_STUDENT), fwptr);
+        return -1;
+    }
+    if (!persistData(USR_STUDENT, fwptr))  // end student mod session
+        return -1;
+
+    return imp_cnt;
+}
+
 
 /*******************************************************************/
 /******************** Screen Navigation Functions ******************/
 /*******************************************************************/
 
 prtEntry(Entry *e) {
-printf("\nAs Entry: %d %d %d\n", e->deleted_flg, e->index, e->ID);   
+printScrf("\nAs Entry: %d %d %d\n", e->deleted_flg, e->index, e->ID);   
 }
 
 prtUsr(User *u) {
-printf("Usr: %d %d %d %s %s %s %s %d %d", u->entry.deleted_flg, u->entry.index, u->entry.ID, u->Fname, u->Lname, u->Addr, u->Dob, u->timeout, u->reg_stat);
+printScrf("Usr: %d %d %d %s %s %s %s %d %d", u->entry.deleted_flg, u->entry.index, u->entry.ID, u->Fname, u->Lname, u->Addr, u->Dob, u->timeout, u->reg_stat);
 prtEntry(u);
 }
 
 prtSub(Subject *s) {
-printf("Subj: %d %d %d %s", s->entry.deleted_flg, s->entry.index, s->entry.ID, s->title);
+printScrf("Subj: %d %d %d %s", s->entry.deleted_flg, s->entry.index, s->entry.ID, s->title);
 prtEntry(s);
 }
 
 prtEnroll(Enrollment *e) {
-printf("Enroll: %d %d %d %d %d", e->entry.deleted_flg, e->entry.index, e->entry.ID, e->studentID, e->teacherID);
+printScrf("Enroll: %d %d %d %d %d", e->entry.deleted_flg, e->entry.index, e->entry.ID, e->studentID, e->teacherID);
 prtEntry(e);
 }
 
 prtLst0(void* list, int list_sz) {
-    printf("Lst Capacity: %d\n", list_sz);
+    printScrf("Lst Capacity: %d\n", list_sz);
     for (int i=0; i<list_sz; i++) 
     if (list == Enrollments)
     prtEnroll(((Enrollment*)list)+i);
@@ -1544,12 +3818,12 @@ prtLst0(void* list, int list_sz) {
     prtSub(((Subject*)list)+i);
     else
     prtUsr(((User*)list)+i);
-    printf("\n");
+    printScrf("\n");
 }
 
 prtLst(char* ttl, int lst_type) {
-    printf(ttl);
-    printf(getTitle("", lst_type, ":\n"));
+    printScrf(ttl);
+    printScrf(getTitle("", lst_type, ":\n"));
     prtLst0(getDataList(lst_type), getDataListSz(lst_type, FALSE));
     pauseScr(NULL,1);
 }
@@ -1578,6 +3852,11 @@ void initSystem()
     WARN_MODE = ERROR_MODE = LG_MODE_ALL;
     DEBUG_MODE = APPLICATION_MODE;
     LOG_NULL_VALUE = "{null}";
+    LOG_FMT = APP_LOG_FMT;
+    scrLogRoute();  // the level settings above are final
+
+    // data file access is synchronized by file locks (see stageListData), hence failed reads are not retried
+    FILE_READ_FRQ = 0;
 
     if (initLogFile() < 0) {
         warn(FILE_UNWRITABLE, APP_LOG_FILENAME, "Application file logging will not be performed.", FALSE);
@@ -1615,6 +3894,8 @@ void initDefaultUsers()
     strcpy(usr->Dob  , "23/05/1975");
     usr->reg_stat = REG_STAT_FULL;
 
+    rebuildListIndex(USR_PRINCIPAL);  // default principal is initialized in place rather than registered
+
     usr = registerUser(USR_TEACHER, hashID(1100));
     strcpy(usr->Fname, "Grace");
     strcpy(usr->Lname, "Peters");
@@ -1665,21 +3946,36 @@ void *loadAppData(int lst_type)
     void* list        = getDataList(lst_type);
     char* dat_fn      = getDataFileName(lst_type);
 
+    const int alt_fmt = DATA_FILE_FORMAT == FMT_BINARY? FMT_TEXT: FMT_BINARY;
+    const int lck     = lockDataFile(dat_fn, TRUE);   // exclusive, as the data file may be migrated or reset
+
     void *ptr  = NULL;
-    FILE *fptr = fopen (dat_fn, "r");
+    FILE *fptr = openDataFile (dat_fn, DATA_FILE_FORMAT, FALSE);
 
-    if (fptr) 
+    scrLogTag(lst_type, 0, 0);   // the load failures logged below are about the list
+
+    if (!fptr && (fptr = openDataFile (getFmtDataFileName(lst_type, alt_fmt), alt_fmt, FALSE)))   // migrate data file from the alternate format
     {
-        if (lst_type == LST_ENROLL) {
-            ptr = loadEnrollData((Enrollment*) list, list_sz_ptr, fptr);
-        } else if (lst_type == LST_SUBJECT) {
-            ptr = loadSubjectData((Subject*) list, list_sz_ptr, fptr);
+        fclose(fptr);
+
+        if (convertDataFile(lst_type, alt_fmt, DATA_FILE_FORMAT)) {
+            list = getDataList(lst_type);   // conversion may have relocated the list
+            fptr = openDataFile (dat_fn, DATA_FILE_FORMAT, FALSE);
         } else {
-            ptr = loadUserData((User*) list, list_sz_ptr, fptr);
-        }  
+            warn(FILE_CORRUPT, getFmtDataFileName(lst_type, alt_fmt), "It could not be converted to the current data file format.", FALSE);
+            fptr = NULL;
+        }
+    }
+
+    if (fptr) 
+    {
+        ptr = loadListData(list, list_sz_ptr, fptr, DATA_FILE_FORMAT);
         fclose(fptr);
 
-        if (!ptr) {
+        if (ptr && !(ptr = replayListJournal(ptr))) {
+            warn(FILE_CORRUPT, getJrnlFileName(lst_type), NULL, FALSE);
+        } 
+        else if (!ptr) {
             warn(FILE_CORRUPT, dat_fn, NULL, FALSE);
         }
     } 
@@ -1687,12 +3983,14 @@ void *loadAppData(int lst_type)
     {
         warn(FILE_UNREADABLE, dat_fn, "(Resetting to default state...", FALSE);  
 
-        if (list && (fptr = fopen(dat_fn, "w")) && commitListData(list, *list_sz_ptr, fptr)) {
+        if (list && (fptr = openDataFile(dat_fn, DATA_FILE_FORMAT, TRUE)) && commitListData(list, *list_sz_ptr, fptr)) {
             warn(NULL, NULL, "Success)", TRUE);
         } else {
             warn(NULL, NULL, "Fail)", TRUE);
         }
     }
+    scrLogTag(0, 0, 0);
+    unlockFile(lck);
 
     return ptr;
 }
@@ -1723,18 +4021,21 @@ FILE *refreshListData(int lst_type, const int read_only_flg, const int auth_mode
     }
 
     int loginID = CURRENT_USR->entry.ID;
-    FILE* fptr  = reloadListData(lst_type, read_only_flg, scr_psd_mode);
+    FILE* fptr;
 
+    // the current user's list is reloaded first so that no other data file lock is awaited while holding a save session lock
     if (lst_type && lst_type != CURRENT_USR_TYPE) {
         reloadListData(NULL, TRUE, scr_psd_mode);
     }
 
+    fptr = reloadListData(lst_type, read_only_flg, scr_psd_mode);
+
     CURRENT_USR = getUser(loginID, NULL);
 
     if (!currentUsr())  // current user refresh/validation failure
     {   
         if (fptr && !read_only_flg) {
-            persistListData(lst_type, fptr, scr_psd_mode);    // recommit previous data since reloading in write mode always clears the source file
+            discardListData(getDataList(lst_type), fptr);    // abandon the save session; the data file remains as is
         }
         if (auth_mode_flg) {
             displayLogoutScreen(LGO_SESS_INVALID);
@@ -1778,9 +4079,9 @@ void displayRetrySubScreen(int rt_mode) {
         strcpy (ex_opt, "Return to previous menu");
     }
 
-    printf ("\n%s (? means any value except 0)\n", ttl);
-    printf ("[?] %s\n", rt_opt);
-    printf ("[0] %s\n", ex_opt);    
+    printScrf ("\n%s (? means any value except 0)\n", ttl);
+    printScrf ("[?] %s\n", rt_opt);
+    printScrf ("[0] %s\n", ex_opt);    
 }
 
 int retry(int rt_mode) {
@@ -1799,19 +4100,19 @@ void displayLogoutScreen(int lg_type) {
 
     switch (lg_type) {
         case LGO_SESS_EXPIRED:
-            printf ("Your user session has expired. Please sign in again to renew your session.");
+            printScrf ("Your user session has expired. Please sign in again to renew your session.");
             printScrMargin(1);
-            printf ("(You can adjust the session expiration time via the EDIT PROFILE option on your HOME menu.)");
+            printScrf ("(You can adjust the session expiration time via the EDIT PROFILE option on your HOME menu.)");
             break;
         case LGO_SESS_INVALID:
-            printf ("Your user session have been invalidated. Please sign in again to renew your session.");
+            printScrf ("Your user session have been invalidated. Please sign in again to renew your session.");
             break;
         default:
-            printf ("You have been signed out for some unknown reason.");
+            printScrf ("You have been signed out for some unknown reason.");
             printScrMargin(2);
-            printf ("If you feel that this has occurred due a haphazard system error you may try signing in again.");
+            printScrf ("If you feel that this has occurred due a haphazard system error you may try signing in again.");
             printScrMargin(1);
-            printf ("If this issue persists, please contact your administrator for further assistance.");
+            printScrf ("If this issue persists, please contact your administrator for further assistance.");
     }
 
     printScrMargin(15);
@@ -1842,16 +4143,18 @@ void displayMainScreen() {
 
     printTopic ("Please select your account type");
 
-    printf ("[1] Student\n");
-    printf ("[2] Teacher\n");
-    printf ("[3] Principal\n");
-    printf ("[0] Exit the program\n");
+    printScrf ("[1] Student\n");
+    printScrf ("[2] Teacher\n");
+    printScrf ("[3] Principal\n");
+    printScrf ("[0] Exit the program\n");
 }
 
 void mainscreen() {
     int choice = -1;
+    SMark mark = scratchMark();
 
     do {
+        scratchRelease(mark);   // transient buffers of the screen last returned from are released in one go
         displayMainScreen();
 
         readOption(&choice);
@@ -1890,15 +4193,17 @@ void displayStudMenuScreen() {
     
     printTopic ("Select an option below");
 
-    printf ("[1] Sign In\n");
-    printf ("[2] Sign Up\n");
-    printf ("[0] Back to Main Menu\n");
+    printScrf ("[1] Sign In\n");
+    printScrf ("[2] Sign Up\n");
+    printScrf ("[0] Back to Main Menu\n");
 }
 
 void studentMenuScreen() {
     int choice = -1;
+    SMark mark = scratchMark();
 
     do {
+        scratchRelease(mark);
         displayStudMenuScreen();
 
         readOption(&choice);
@@ -1936,7 +4241,7 @@ int displayProfRegScreen(int usr_type, int reg_chkpnt, const int edit_mode_flg,
         displayProfileView(NULL, usr_type); 
     }
 
-    printf ("\nPlease provide your profile information below (press ENTER to skip optional details)\n");
+    printScrf ("\nPlease provide your profile information below (press ENTER to skip optional details)\n");
 
     return TRUE;
 }
@@ -2017,6 +4322,8 @@ int userProfileRegScreen(int usr_type, int reg_chkpnt) {
                                     enrolls[i].teacherID = CURRENT_USR->entry.ID;
                             }
                         }     
+                        rebuildListIndex(LST_ENROLL);
+
                         result *= persistListData(LST_ENROLL, efwptr, SCR_PSD_OFF);  // conclude enrollment mod session (in quiet mode)
                     } else {
                         warn(REFRESH_ERROR, "enrollment", NULL, FALSE);
@@ -2080,7 +4387,10 @@ int processUserAccount(int usr_type, const int reg_chkpnt, const int edit_mode_f
                 else if (CURRENT_USR->entry.ID == loginID) {
                     result = -TRUE;
                 } else {
+                    unindexListEntry(usr_type, (Entry*) CURRENT_USR);
                     CURRENT_USR->entry.ID = loginID; 
+                    indexListEntry(usr_type, (Entry*) CURRENT_USR);
+                    setDataStamp(usr_type, NULL);   // in-memory change not yet reflected in the data file
                     result = TRUE;
                 }
             }
@@ -2097,7 +4407,7 @@ int processUserAccount(int usr_type, const int reg_chkpnt, const int edit_mode_f
             }
         }
 
-        printf("\nThe login ID entered is either already taken or invalid. Please provide a different ID between %d and %d.\n", PASSCODE_MN, PASSCODE_MX);
+        printScrf("\nThe login ID entered is either already taken or invalid. Please provide a different ID between %d and %d.\n", PASSCODE_MN, PASSCODE_MX);
 
         if (!retry(0)) {
             return FALSE;
@@ -2124,7 +4434,7 @@ int processUserName(User* usr, const int edit_mode_flg) {
             break;
         }
 
-        printf("The name is invalid! Please specify a non-blank first name.");
+        printScrf("The name is invalid! Please specify a non-blank first name.");
    
     } while (TRUE);
 
@@ -2173,15 +4483,15 @@ int processUserDob(User* usr, const int edit_mode_flg) {
         if (convertDate(trim(dob, -1, NULL, 0), &tm)) 
         {
             if (tm.tm_year < 0) {
-                printf("Invalid date of birth! Please specify a date with year 1900 or later.\n");
+                printScrf("Invalid date of birth! Please specify a date with year 1900 or later.\n");
             } else if (calculateAge(&tm, NULL) < 0) {
-                printf("Date of birth cannot be in the future!\n");
+                printScrf("Date of birth cannot be in the future!\n");
             } else {
                 strcpy(usr->Dob, dob);
                 return TRUE;
             }
         } else {
-            printf("The date is invalid! Please specify date in the correct format.\n");
+            printScrf("The date is invalid! Please specify date in the correct format.\n");
         }
    
     } while (TRUE);
@@ -2203,7 +4513,7 @@ int processUserTimeout(User* usr, const int edit_mode_flg) {
             return TRUE;
         }
 
-        printf("The timeout duration is invalid! Please enter a positive integer value.\n");
+        printScrf("The timeout duration is invalid! Please enter a positive integer value.\n");
    
     } while (TRUE);
 }
@@ -2229,9 +4539,14 @@ void subjectRegScreen(int loginID, const int actn_mode)  // NOTE: subject regist
     Enrollment* enrolls = getDataList(LST_ENROLL);
     
     Enrollment*enroll;
-    Enrollment enroll_buf  [subjects_sz];  // refers to newly created enrollment entries based on user selection
-    int   subject_ids      [subjects_sz];  // refers to indexes of either enrolled or available subjects
+    Enrollment*enroll_buf  = scratchAlloc(subjects_sz * ENROLL_SZ);  // refers to newly created enrollment entries based on user selection
+    int*  subject_ids      = scratchAlloc(subjects_sz * sizeof(int));  // refers to indexes of either enrolled or available subjects
     int   enroll_cnt  = 0, subj_total; 
+
+    if (!(enroll_buf && subject_ids)) {
+        sys_err (NULL, MSG_ACTN_ABORT, SCR_PSD_ON, FALSE);
+        return;
+    }
     
 top:    
     displayScreenSubHdr(getTitle(actn_mode < 0 ? NULL: edit_mode_flg ? "EDIT ":"CONTINUE ", LST_SUBJECT, " REGISTRATION"));
@@ -2272,12 +4587,12 @@ top:
     }
  
     // prompt for and process enrollment input
-    printf ("\n\nPlease provide your course information below (press ENTER when finished)\n");
-    printf ("\n(Specify any pair of numbers associated with a subject and teacher from the list.");
-    printf ("\n Note that a subject can only be paired with a single teacher, however the same");
-    printf ("\n teacher may be paired with multiple subjects. Also note that, if enrolling for");
-    printf ("\n the first time, at least one subject must be chosen in order to complete the");
-    printf ("\n registration.)\n\n");
+    printScrf ("\n\nPlease provide your course information below (press ENTER when finished)\n");
+    printScrf ("\n(Specify any pair of numbers associated with a subject and teacher from the list.");
+    printScrf ("\n Note that a subject can only be paired with a single teacher, however the same");
+    printScrf ("\n teacher may be paired with multiple subjects. Also note that, if enrolling for");
+    printScrf ("\n the first time, at least one subject must be chosen in order to complete the");
+    printScrf ("\n registration.)\n\n");
 
     do {
         result = promptOptions("Enter course info (Subject No. Teacher No.): ", &subj_no, &tchr_no);
@@ -2293,11 +4608,11 @@ top:
         else if (result)
         {  
             if (subj_no > subj_total) {
-                printf("The entered subject no. is incorrect. Please specify a valid subject no. from the list above.\n");
+                printScrf("The entered subject no. is incorrect. Please specify a valid subject no. from the list above.\n");
                 continue;
             } 
             else if (tchr_no > teachers_sz || teachers[tchr_no-1].entry.deleted_flg) {
-                printf("The entered teacher no. is incorrect. Please specify a teacher no. from the list above.\n");
+                printScrf("The entered teacher no. is incorrect. Please specify a teacher no. from the list above.\n");
                 continue;
             }
             
@@ -2324,7 +4639,7 @@ top:
             } 
         }
         else 
-            printf("The entered course information is invalid. Please specify enrollment options according to the syntax given.\n"); 
+            printScrf("The entered course information is invalid. Please specify enrollment options according to the syntax given.\n"); 
 
     } while (TRUE);
 
@@ -2385,11 +4700,11 @@ void loginScreen()
         }
 
         if (reg_err_flg) {
-            printf ("\nThe entered login ID is invalid. Please enter a different ID or report this incident to your administrator.\n");
+            printScrf ("\nThe entered login ID is invalid. Please enter a different ID or report this incident to your administrator.\n");
         } else {
-            printf ("\nThe entered login ID is either not found or incorrect.");
+            printScrf ("\nThe entered login ID is either not found or incorrect.");
             if(CURRENT_USR_TYPE == USR_STUDENT)
-            printf ("\n(If you do not have an account you can create one via the SIGN UP option on the previous screen.)\n");
+            printScrf ("\n(If you do not have an account you can create one via the SIGN UP option on the previous screen.)\n");
         }
    
         if (!retry(0)) {
@@ -2405,31 +4720,35 @@ void displayUserHomeScreen() {
     
     printTopic ("Select an option below");
 
-    printf ("[1] View Profile\n");
-    printf ("[2] Edit Profile\n");
-    printf ("[3] View Subjects\n");
+    printScrf ("[1] View Profile\n");
+    printScrf ("[2] Edit Profile\n");
+    printScrf ("[3] View Subjects\n");
 
     switch (CURRENT_USR_TYPE) {
     case USR_STUDENT:
-        printf ("[4] Add Subjects\n");
-        printf ("[5] Drop Subjects\n");
+        printScrf ("[4] Add Subjects\n");
+        printScrf ("[5] Drop Subjects\n");
         break;
     case USR_TEACHER:
-        printf ("[4] Edit Grades\n");
+        printScrf ("[4] Edit Grades\n");
         break;
     case USR_PRINCIPAL:  
-        printf ("[4] View Teachers\n"); 
-        printf ("[5] View Students\n");    
-        printf ("[6] Reassign Teachers\n");    
-        printf ("[7] Deregister Student\n");     
+        printScrf ("[4] View Teachers\n"); 
+        printScrf ("[5] View Students\n");    
+        printScrf ("[6] Reassign Teachers\n");    
+        printScrf ("[7] Deregister Student\n");     
+        printScrf ("[8] Import Data\n");     
+        printScrf ("[9] Compact Data\n");     
     }
-    printf ("[0] Sign Out\n");
+    printScrf ("[0] Sign Out\n");
 }
 
 void userHomeScreen(){
     int choice = -1;
+    SMark mark = scratchMark();
 
     do {
+        scratchRelease(mark);
         displayUserHomeScreen();
 
         readOption(&choice);
@@ -2494,6 +4813,14 @@ void userHomeScreen(){
                 case 7:
                 editEnrollmentScreen(USR_ACTN_REM);
                 continue;
+
+                case 8:
+                importDataScreen();
+                continue;
+
+                case 9:
+                compactDataScreen();
+                continue;
             }
         }
 
@@ -2508,6 +4835,8 @@ void displayProfileView(User* usr, int usr_type)
     
     int hmargin = 8, len;
     float avg;
+    char band [16];
+    GradeAggr aggr;
 
     if (!usr) usr = CURRENT_USR;
     if (!usr_type) usr_type = CURRENT_USR_TYPE;
@@ -2580,7 +4909,25 @@ void displayProfileView(User* usr, int usr_type)
         printScrColVal(getDataListCnt(USR_STUDENT), 0, 0, "\n");
         printScrHMargin(hmargin);
         printScrColText("School Avg Grade:", MAX_COL_SZ, NULL);
-        printGrade(avg, "\n\n");
+        printGrade(avg, "\n");
+
+        calculateGradeAggr(0, usr_type, &aggr);
+
+        printScrHMargin(hmargin);
+        printScrColText("Lowest Grade:", MAX_COL_SZ, NULL);
+        printGrade(aggr.min, "\n");
+        printScrHMargin(hmargin);
+        printScrColText("Highest Grade:", MAX_COL_SZ, NULL);
+        printGrade(aggr.max, "\n\n");
+
+        printScrTitle(NULL, "----- GRADE DISTRIBUTION -----", "\n\n");
+
+        for (int i = 0; i < GRADE_HIST_SZ; i++) {
+            sprintf(band, "%d - %d%%:", i * 10, i < GRADE_HIST_SZ - 1 ? i * 10 + 9 : 100);
+            printScrHMargin(hmargin);
+            printScrColText(band, MAX_COL_SZ, NULL);
+            printScrColVal(aggr.hist[i], 0, 0, i < GRADE_HIST_SZ - 1 ? "\n" : "\n\n");
+        }
     }
 
     printScrTitle(NULL, "----- ACCOUNT INFORMATION -----", "\n\n");
@@ -2607,16 +4954,16 @@ void viewProfileScreen(User* usr, int usr_type) {
     pauseScr("\n", TRUE);
 }
 
-int displaySubjListView(User* usr, int usr_type, Enrollment**enrolls_ptr, int* subj_total_ptr) 
+int displaySubjListView(User* usr, int usr_type, Enrollment**enrolls_ptr, int* subj_total_ptr, int* page_ptr)   // returns the no. of pages
 {
     const int ITEM_SZ = ITEM_NO_SZ   + SCR_PADDING;
     const int NAME_SZ = FULL_NAME_SZ + SCR_PADDING;
     const int SUBJ_SZ = SUBJ_TTL_SZ  + SCR_PADDING;
 
-    int uID, subj_total = *subj_total_ptr; 
+    int uID, subj_total = *subj_total_ptr, page_sz = getPageSz(), page_cnt; 
     char* name;
     Subject* subj;
-    Enrollment* e, *subj_enrolls_ptr [getDataListSz(LST_SUBJECT, TRUE)];
+    Enrollment* e, **subj_enrolls_ptr;
     
 
     if (!usr) usr = CURRENT_USR;
@@ -2628,28 +4975,35 @@ int displaySubjListView(User* usr, int usr_type, Enrollment**enrolls_ptr, int* s
     int tbl_margin = print4ColTblHdr("No.", ITEM_SZ, "Subject", SUBJ_SZ, tchr_flg?"Student":"Teacher", NAME_SZ, "Grade (%)", GRADE_SZ);
 
     if (subj_total < 0) {
-        subj_total = enrollSearch(usr->entry.ID, usr_type, NULL, -1, 0, tchr_flg? subj_enrolls_ptr: enrolls_ptr, 0);
 
         if (tchr_flg) 
         {
+            SMark mark = scratchMark();
             int stud_total = 0;
 
+            subj_enrolls_ptr = scratchAlloc(getDataListSz(LST_SUBJECT, TRUE) * PTR_SZ);
+            subj_total = subj_enrolls_ptr? enrollSearch(usr->entry.ID, usr_type, NULL, -1, 0, subj_enrolls_ptr, 0): 0;
+
             for (int i=0; i < subj_total; i++) {
-                stud_total += enrollSearch(NULL, subj_enrolls_ptr[i]->entry.ID, NULL, usr->entry.ID, 0, enrolls_ptr + stud_total, 0);
+                stud_total += enrollSearch(0, subj_enrolls_ptr[i]->entry.ID, 0, usr->entry.ID, 0, enrolls_ptr + stud_total, 0);
             }
+            scratchRelease(mark);
 
             *subj_total_ptr = stud_total;
         } 
         else {
-            *subj_total_ptr = subj_total;
+            *subj_total_ptr = enrollSearch(usr->entry.ID, usr_type, NULL, -1, 0, enrolls_ptr, 0);
         }
+        subj_total = *subj_total_ptr;
     }
 
-    // populate table with subject & teacher listings
+    page_cnt = getPageCnt(subj_total, page_sz, page_ptr);
+
+    // populate table with the subject & teacher listings of the page
     if (subj_total == 0) 
         printScrTitle(NULL, MSG_EMPTY_LIST, NULL);
     else
-    for (int i = 0; i < subj_total; i++) 
+    for (int i = *page_ptr * page_sz; i < subj_total && i < (*page_ptr + 1) * page_sz; i++) 
     {
         e    = enrolls_ptr[i];
         uID  = usr_type==USR_TEACHER? e->studentID : e->teacherID;
@@ -2663,7 +5017,10 @@ int displaySubjListView(User* usr, int usr_type, Enrollment**enrolls_ptr, int* s
         printGrade(e->grade, "\n");
     }
 
+    printPageFtr(*page_ptr, page_cnt, tbl_margin);
     printScrVMargin(2);
+
+    return page_cnt;
 }
 
 void subjectListScreen(const int edit_mode_flg) {
@@ -2674,18 +5031,28 @@ void subjectListScreen(const int edit_mode_flg) {
     int subj_total = -1;
     int enroll_cnt =  0;
     int enrolls_sz = getDataListSz(LST_ENROLL, TRUE);
+    int page = 0, page_cnt;
     
-    Enrollment*enrolls_ptr[enrolls_sz];  // subject enrollment entries belonging to the given user
-    Enrollment enroll_buf [enrolls_sz];  // updated enrollment entries based on user input
+    Enrollment**enrolls_ptr = scratchAlloc(enrolls_sz * PTR_SZ);     // subject enrollment entries belonging to the given user
+    Enrollment* enroll_buf  = scratchAlloc(enrolls_sz * ENROLL_SZ);  // updated enrollment entries based on user input
+
+    if (!(enrolls_ptr && enroll_buf)) {
+        sys_err (NULL, MSG_ACTN_ABORT, SCR_PSD_ON, FALSE);
+        return;
+    }
     
     do {
 
         displayScreenSubHdr(getTitle(NULL, NULL, " SUBJECTS"));
 
-        displaySubjListView(NULL, NULL, enrolls_ptr, &subj_total);
+        page_cnt = displaySubjListView(NULL, NULL, enrolls_ptr, &subj_total, &page);
+
+        if (page_cnt > 1 && promptPageOpt(MSG_PAGE_NAV, NULL, &page, page_cnt) < 0)
+            continue;
 
         if (!edit_mode_flg) {
-            pauseScr (NULL, TRUE);
+            if (page_cnt <= 1) 
+                pauseScr (NULL, TRUE);
             return;
         }
         
@@ -2710,10 +5077,10 @@ int editGrades(Enrollment**enrolls_ptr, int subj_total, Enrollment* enroll_buf,
     Enrollment* enroll;
 
     // prompt for and process subject grades
-    printf ("\n\nPlease provide the subject grade information below (press ENTER when finished)\n");
-    printf ("\n(Specify the subject no. from the list and the grade to be associated with the subject.");
-    printf ("\n Note that subject grades can by edited multiple times, with the last edit used as the");
-    printf ("\n final grade for each subject.)\n\n");
+    printScrf ("\n\nPlease provide the subject grade information below (press ENTER when finished)\n");
+    printScrf ("\n(Specify the subject no. from the list and the grade to be associated with the subject.");
+    printScrf ("\n Note that subject grades can by edited multiple times, with the last edit used as the");
+    printScrf ("\n final grade for each subject.)\n\n");
 
     do {
         result = promptOptVal("Enter course info (Subject No. Grade): ", &subj_no, &grade, FALSE);
@@ -2728,11 +5095,11 @@ int editGrades(Enrollment**enrolls_ptr, int subj_total, Enrollment* enroll_buf,
         else if (result)
         {  
             if (subj_no > subj_total) {
-                printf("The entered subject no. is incorrect. Please specify a valid subject no. from the list above.\n");
+                printScrf("The entered subject no. is incorrect. Please specify a valid subject no. from the list above.\n");
                 continue;
             } 
             else if (grade < 0) {
-                printf("The entered grade is invalid. Please specify a grade greater than or equal to zero.\n");
+                printScrf("The entered grade is invalid. Please specify a grade greater than or equal to zero.\n");
                 continue;
             }
             
@@ -2748,7 +5115,7 @@ int editGrades(Enrollment**enrolls_ptr, int subj_total, Enrollment* enroll_buf,
             } 
         }
         else 
-            printf("The entered course information is invalid. Please specify options according to the syntax given.\n"); 
+            printScrf("The entered course information is invalid. Please specify options according to the syntax given.\n"); 
 
     } while (TRUE);
 
@@ -2765,12 +5132,12 @@ int dropSubject(Enrollment**enrolls_ptr, int subj_total)
 {
     int choice = 0;
 
-    printf("Please enter the subject no. for the course you desire to remove.\n\n");
+    printScrf("Please enter the subject no. for the course you desire to remove.\n\n");
 
     promptInt("Enter Subject No.: ", &choice, ITEM_NO_SZ);
 
     if (!choice || choice > subj_total) {
-        printf("The entered subject no. is incorrect. Please specify a valid subject no. from the list above.\n");
+        printScrf("The entered subject no. is incorrect. Please specify a valid subject no. from the list above.\n");
         return ! retry(0);
     } 
    
@@ -2789,7 +5156,9 @@ int dropSubject(Enrollment**enrolls_ptr, int subj_total)
             strcat(entry_key, "+");
             strcat(entry_key, e_cpy.studentID);
             
+            scrLogTag(LST_ENROLL, e_cpy.entry.ID, 0);
             warn(NO_ENTRY_ERROR, entry_key, "It may have been removed externally.", FALSE);
+            scrLogTag(0, 0, 0);
         }
 
         persistData(LST_ENROLL, fwptr);  // end mod session
@@ -2798,9 +5167,10 @@ int dropSubject(Enrollment**enrolls_ptr, int subj_total)
     return TRUE;
 }
 
-void displayEnrollStatsView(int usr_type, Entry* list, int list_sz, const int show_stats, const int show_grade) 
+int displayEnrollStatsView(int usr_type, Entry* list, int list_sz, const int show_stats, const int show_grade, int* page_ptr)   // returns the no. of pages
 {
     const int usr_flg  =  usr_type==USR_STUDENT || usr_type==USR_TEACHER;
+    const int lst_type =  usr_flg? usr_type: LST_SUBJECT;
     const int ENTRY_SZ = (usr_flg? FULL_NAME_SZ *1/3 : SUBJ_TTL_SZ) + SCR_PADDING;
     const int RG_STAT_SZ  = REG_STAT_SZ + SCR_PADDING;
     const int ITEM_SZ     = ITEM_NO_SZ  + SCR_PADDING;
@@ -2808,6 +5178,9 @@ void displayEnrollStatsView(int usr_type, Entry* list, int list_sz, const int sh
 
     char *col_hdr2, *col_hdr3, *col_hdr4, *col_hdr5, *col_hdr6; 
     int entryID, sz_col5, tgt_col4, tgt_col5;
+    int page_sz  = getPageSz(), row = 0;
+    int page_cnt = getPageCnt(getDataListCnt(lst_type), page_sz, page_ptr);
+    Entry* entry;
 
     col_hdr3 = usr_flg?    "Reg Status":NULL;
     col_hdr6 = show_grade? "Avg Grade (%)":NULL;
@@ -2837,21 +5210,23 @@ void displayEnrollStatsView(int usr_type, Entry* list, int list_sz, const int sh
 
     int tbl_margin = print6ColTblHdr("No.", ITEM_SZ, col_hdr2, ENTRY_SZ, col_hdr3, RG_STAT_SZ, col_hdr4, STAT_SZ, col_hdr5, STAT_SZ, col_hdr6, GRADE_SZ);
 
-    for (int i = 0; i < list_sz; i++) 
+    for (int i = nextLiveEntry(lst_type, 0, list_sz); i >= 0 && row < (*page_ptr + 1) * page_sz; i = nextLiveEntry(lst_type, i + 1, list_sz))   // list is the global data list
     {
-        if (list->deleted_flg)
-            continue;
+        entry = getEntry(lst_type, list, i);
+
+        if (row++ < *page_ptr * page_sz)
+            continue;   // the rows of previous pages are skipped without computing their stats
 
-        entryID = list[i].ID;
+        entryID = entry->ID;
 
         printScrHMargin(tbl_margin);
 
         printScrColVal(i + 1, ITEM_SZ, 0, NULL);
         
-        printScrColText(usr_flg? getFullName(((User*) list) + i) : ((Subject*) list)[i].title, ENTRY_SZ, NULL);
+        printScrColText(usr_flg? getFullName((User*) entry) : ((Subject*) entry)->title, ENTRY_SZ, NULL);
 
         if (usr_flg) {
-            printScrColText(getRegStatDesc(((User*) list)[i].reg_stat, TRUE), STAT_SZ, NULL);
+            printScrColText(getRegStatDesc(((User*) entry)->reg_stat, TRUE), STAT_SZ, NULL);
         }
         if (show_stats) {
             printScrColVal(calculateTally(entryID, usr_type, tgt_col4), ITEM_SZ, 0, NULL);
@@ -2864,7 +5239,10 @@ void displayEnrollStatsView(int usr_type, Entry* list, int list_sz, const int sh
         printScrVMargin(1);
     }
 
+    printPageFtr(*page_ptr, page_cnt, tbl_margin);
     printScrVMargin(2);
+
+    return page_cnt;
 }
 
 void viewEnrollmentScreen(int usr_type) {
@@ -2877,31 +5255,38 @@ void viewEnrollmentScreen(int usr_type) {
     if (!(refreshData(LST_ENROLL, READ_ONLY, SECURED) && currentUsr()))
         return;
 
-    Entry* list = getDataList(usr_flg? usr_type :LST_SUBJECT);
-    int list_sz = getDataListSz(usr_flg? usr_type :LST_SUBJECT, FALSE);
+    int lst_type = usr_flg? usr_type :LST_SUBJECT;
+    Entry* list;
+    int list_sz;
 
-    int choice = 0;
+    int choice = 0, page = 0, page_cnt;
     
     do {
+        list    = getDataList(lst_type);  // the list may have been reloaded by the profile screen
+        list_sz = getDataListSz(lst_type, FALSE);
 
-        displayScreenSubHdr(getTitle(NULL, usr_flg? usr_type: LST_SUBJECT, " ENROLLMENTS"));
+        displayScreenSubHdr(getTitle(NULL, lst_type, " ENROLLMENTS"));
 
-        displayEnrollStatsView(usr_type, list, list_sz, TRUE, TRUE);
+        page_cnt = displayEnrollStatsView(usr_type, list, list_sz, TRUE, TRUE, &page);
 
         if (!usr_flg) {
-            pauseScr (NULL, TRUE);
+            if (page_cnt > 1 && promptPageOpt(MSG_PAGE_NAV, NULL, &page, page_cnt) < 0)
+                continue;
+            if (page_cnt <= 1) 
+                pauseScr (NULL, TRUE);
             return;
         }
         
-        printf("\nSelect an item no. from the list in order to view additional details.\n\n");
+        printScrf("\nSelect an item no. from the list in order to view additional details.\n\n");
 
-        promptInt("Enter Item No.: ", &choice, ITEM_NO_SZ);
+        if (promptPageOpt("Enter Item No.: ", &choice, &page, page_cnt) < 0)
+            continue;
 
-        if (!choice || choice > list_sz || list[choice-1].deleted_flg) {
-            printf("The entered item no. is incorrect. Please specify a valid item no. from the list above.\n");
+        if (!choice || choice > list_sz || ((Entry*) getEntry(lst_type, list, choice-1))->deleted_flg) {
+            printScrf("The entered item no. is incorrect. Please specify a valid item no. from the list above.\n");
             if (!retry(0)) break;
         } else {
-            viewProfileScreen(list + choice-1, usr_type);
+            viewProfileScreen(getEntry(lst_type, list, choice-1), usr_type);
         }
 
     } while (TRUE);
@@ -2915,15 +5300,24 @@ void editEnrollmentScreen(const int actn_mode) {
     int subj_total = -1;
     int enroll_cnt =  0;
     int enrolls_sz = getDataListSz(LST_ENROLL, TRUE);
+    int page = 0, page_cnt;
     
-    Enrollment*enrolls_ptr[enrolls_sz];  // subject enrollment entries belonging to the given user
-    Enrollment enroll_buf [enrolls_sz];  // updated enrollment entries based on user input
+    Enrollment**enrolls_ptr = scratchAlloc(enrolls_sz * PTR_SZ);     // subject enrollment entries belonging to the given user
+    Enrollment* enroll_buf  = scratchAlloc(enrolls_sz * ENROLL_SZ);  // updated enrollment entries based on user input
+
+    if (!(enrolls_ptr && enroll_buf)) {
+        sys_err (NULL, MSG_ACTN_ABORT, SCR_PSD_ON, FALSE);
+        return;
+    }
     
     do {
 
         displayScreenSubHdr(getTitle(NULL, NULL, " SUBJECTS"));
 
-        displaySubjListView(NULL, NULL, enrolls_ptr, &subj_total);
+        page_cnt = displaySubjListView(NULL, NULL, enrolls_ptr, &subj_total, &page);
+
+        if (page_cnt > 1 && promptPageOpt(MSG_PAGE_NAV, NULL, &page, page_cnt) < 0)
+            continue;
         
         if (CURRENT_USR_TYPE == USR_TEACHER) 
         {
@@ -2937,4 +5331,110 @@ void editEnrollmentScreen(const int actn_mode) {
         }
 
     } while (TRUE);
-}
\ No newline at end of file
+}
+
+void displayImportScreen() {
+
+    displayScreenSubHdr("IMPORT DATA");
+
+    printTopic ("Select the data to be imported");
+
+    printScrf ("[1] Students\n");
+    printScrf ("[2] Teachers\n");
+    printScrf ("[3] Enrollments\n");
+    printScrf ("[0] Back\n");
+}
+
+void importDataScreen() {
+    int choice = -1;
+    SMark mark = scratchMark();
+
+    do {
+        scratchRelease(mark);
+        displayImportScreen();
+
+        readOption(&choice);
+
+        switch (choice)
+        {
+            case 1:
+            importFileScreen(USR_STUDENT);
+            break;
+
+            case 2:
+            importFileScreen(USR_TEACHER);
+            break;
+
+            case 3:
+            importFileScreen(LST_ENROLL);
+            break;
+
+            case 0:
+            return; // to home screen
+
+            default:
+            pauseScr (MSG_INVALID_OPTION, TRUE);
+        }
+
+    } while (TRUE);
+}
+
+void compactDataScreen() {
+    const int lst_types [] = {USR_STUDENT, USR_TEACHER, LST_SUBJECT, LST_ENROLL};
+    char msg [SCR_SIZE];
+    int  sqz_cnt, total = 0;
+
+    displayScreenSubHdr("COMPACT DATA");
+
+    printTopic ("Tombstoned slots reclaimed from each list");
+
+    for (int i = 0; i < (int) (sizeof(lst_types) / sizeof(*lst_types)); i++) 
+    {
+        if (getDataLock(lst_types[i]) >= 0) {   // the slots of a list are diffed against its staged copy during a save session
+            printScrf ("  %-12s skipped (save in progress)\n", getTitle(NULL, lst_types[i], "S"));
+            continue;
+        }
+        total += sqz_cnt = squeezeListData(lst_types[i]);
+
+        printScrf ("  %-12s %d\n", getTitle(NULL, lst_types[i], "S"), sqz_cnt);
+    }
+
+    sprintf(msg, "%d slot(s) reclaimed in total.", total);
+    inform(1, 1, msg, SCR_PSD_ON, FALSE);
+}
+
+void importFileScreen(int lst_type) {
+    char fname [FILENAME_MAX], msg [SCR_SIZE];
+    int  imp_cnt, rej_cnt = 0;
+    FILE* fptr;
+
+    displayScreenSubHdr(getTitle("IMPORT ", lst_type, "S"));
+
+    printScrf ("\nEach line of the CSV file must hold one record with the following fields (a header line is optional):\n\n  %s\n\n", 
+            lst_type == LST_ENROLL? "Subject ID, Student Login ID, Teacher Login ID[, Grade]": 
+                                    "Login ID, First Name, Last Name, Address, Date of Birth (DD/MM/YYYY)[, Session Timeout (mins)]");
+
+    promptLn("Enter CSV File Name: ", fname, FILENAME_MAX - 1);
+
+    if (!*trim(fname, -1, NULL, FTRIM)) 
+        return;
+
+    if (!(fptr = fopen(fname, "r"))) {
+        warn(FILE_UNREADABLE, fname, NULL, FALSE);
+        pauseScr(NULL, TRUE);
+        return;
+    }
+
+    if (lst_type == LST_ENROLL) {
+        imp_cnt = importEnrollData(fptr, &rej_cnt);
+    } else {
+        imp_cnt = importUserData(lst_type, fptr, &rej_cnt);
+    }
+    fclose(fptr);
+
+    if (imp_cnt < 0) 
+        return;   // the failure has already been reported
+
+    sprintf(msg, "%d record(s) imported, %d record(s) rejected%s", imp_cnt, rej_cnt, rej_cnt? " (see the application log for details).": ".");
+    inform(1, 1, msg, SCR_PSD_ON, FALSE);
+}
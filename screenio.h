@@ -1,13 +1,27 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <stdarg.h>     // For variadic screen output (see printScrf())
 #include <ctype.h>      // For isspace(), isdigit() & isprint() functions 
-#include <time.h>       // For strftime() function
+#include <time.h>       // For strftime(), timespec_get() and clock_gettime() functions
+#include <stdint.h>     // For fixed-width integer types (used by binary log records)
+#include <sys/stat.h>   // For stat() function
+#include <errno.h>      // For errno variable
+#include <signal.h>     // For signal() function
 #if defined(_WIN32) || defined(__CYGWIN__)
-#include <windows.h>    // For Windows Sleep() function and getpass() implementation
+#include <windows.h>    // For Windows Sleep() function, getpass() implementation and file mapping
+#include <io.h>         // For _commit() function
+#include <fcntl.h>      // For _open() flags (and, on Cygwin, fcntl() file locks)
+#ifdef __CYGWIN__
+#include <unistd.h>     // For close() function (Cygwin file locks)
+#endif
 #else
 #include <unistd.h>     // For Linux sleep() function
 #include <termios.h>    // For getpass() implementation
+#include <fcntl.h>      // For open() and fcntl() functions
+#include <sys/mman.h>   // For mmap() function
+#include <sys/ioctl.h>  // For ioctl() function (terminal dimensions)
+#include <pthread.h>    // For pthread_create() and pthread_join() functions
 #endif
 
 // Log file default title
@@ -26,6 +40,16 @@
 #define LG_MODE_FILE  2
 #define LG_MODE_ALL   3
 
+// Log file format enumeration
+#define LOG_FMT_TEXT 0  // free-form text lines
+#define LOG_FMT_JSON 1  // one JSON object per line: {"ts":<epoch secs>,"level":"<name>","list":<list type>,"key":<entry key>,"rec":<record no.>,"msg":"<message>"}
+#define LOG_FMT_BIN  2  // one LBinRec header per entry, immediately followed by its (unterminated) message characters
+
+// Timestamp mode enumeration
+#define TMS_MODE_SEC  0 // local time to the second
+#define TMS_MODE_MS   1 // local time to the millisecond
+#define TMS_MODE_MONO 2 // monotonic time elapsed since the first timestamp, to the millisecond (for latency tracing)
+
 // Screen pause mode enumeration
 #define SCR_PSD_OFF      -2
 #define SCR_PSD_OFF_PRMPT-1
@@ -41,16 +65,133 @@
 #define FALSE 0
 #define TRUE  1
 
+// ANSI terminal control sequences
+#define ANSI_CLEAR "\033[H\033[2J\033[3J"    // homes the cursor, then clears the screen and its scrollback
+#define ANSI_MOVE  "\033[%d;1H"             // moves the cursor to the start of a (1-based) row
+#define ANSI_CLR_LN  "\033[K"               // clears the rest of the row
+#define ANSI_CLR_SCR "\033[J"               // clears the rest of the screen
+#define ANSI_CLR_HIST "\033[3J"            // clears the scrollback
+#define ANSI_SCROLL_DN "\033[%dT"          // scrolls the screen down by a no. of rows (blanking the rows at its top)
+#if defined(_WIN32) || defined(__CYGWIN__)
+#ifndef ENABLE_VIRTUAL_TERMINAL_PROCESSING
+#define ENABLE_VIRTUAL_TERMINAL_PROCESSING 0x0004
+#endif
+#endif
+
+// Memory read cursor (used to parse file contents that are mapped into memory)
+struct MemCursor {
+    const char *pos;
+    const char *end;
+};
+typedef struct MemCursor MCursor;
+
+// Screen frame buffer (screen output is composed in memory and written to the console in one go, see scrFlush())
+struct FrameBuffer {
+    char *buf;
+    int   len;
+    int   cap;
+    int   sync_flg;  // TRUE while the frame mirrors the console, echoed input included (shadow frame only)
+};
+typedef struct FrameBuffer FBuffer;
+
+// Clock cache (the local time of the current second, refreshed only when the second ticks over)
+struct ClockCache {
+    time_t    sec;
+    struct tm tm;
+    char      tms[24];  // formatted as "[%Y-%m-%d %H:%M:%S" (the closing bracket is appended as per the timestamp mode)
+};
+typedef struct ClockCache CCache;
+
+// Log file sink (an open, block-buffered log file stream shared by all log levels that write to the file)
+struct LogSink {
+    char  *fname;
+    FILE  *fptr;
+    time_t dirty;   // time at which the oldest unflushed log entry was buffered (0 if none)
+};
+typedef struct LogSink LSink;
+
+// Log level route (the mode, timestamp mode and sink of a log level, resolved once by scrLogRoute())
+struct LogRoute {
+    const char *level;
+    const char *name;   // level name written to structured log records
+    int    mode;
+    int    tms_mode;
+    char  *fname;
+    LSink *sink;        // opened upon the first entry logged to the file
+};
+typedef struct LogRoute LRoute;
+
+// Log entry tag (the list, entry and/or import record that a log entry is about; 0 if not applicable)
+struct LogTag {
+    int lst_type;
+    int entry_key;
+    int rec_no;
+};
+typedef struct LogTag LTag;
+
+// Binary log record header (see LOG_FMT_BIN)
+struct LogBinRecord {
+    int64_t tms;
+    int32_t lst_type;
+    int32_t entry_key;
+    int32_t rec_no;
+    int16_t msg_len;
+    char    level;      // first character of the level name (I, W, E, F or D)
+    char    cntd_flg;   // continuation of the previous entry
+};
+typedef struct LogBinRecord LBinRec;
+
+// Parallel task (a function and its argument, run by a worker thread, see runParallel())
+struct ParallelTask {
+    void (*fn)(void*);
+    void  *arg;
+};
+typedef struct ParallelTask PTask;
+
+// Scratch arena block (transient buffers are carved out of a chain of blocks and released in one go, see scratchAlloc())
+struct ScratchBlock {
+    struct ScratchBlock *prev;
+    int  size;       // no. of bytes in use
+    int  capacity;   // no. of bytes available in data
+    char data [];
+};
+typedef struct ScratchBlock SBlock;
+
+// Scratch arena mark (the arena position to which scratchRelease() returns)
+struct ScratchMark {
+    SBlock *blk;
+    int     size;
+};
+typedef struct ScratchMark SMark;
+
 // Screen display properties (measured in characters)
 static int SCR_SIZE = 120;
 static int SCR_PADDING = 5;
 
-// Synchronized read settings
+// Synchronized read settings (retries may be disabled where file access is synchronized by file locks, see lockFile())
 static int FILE_READ_FRQ = 20;      // no. of retries upon read failure
 static int FILE_READ_LAT = 50;      // wait interval between each retry (in milliseconds)
 
 static int OPTION_MAX_SZ = 1;       // max. character width for any given menu option
 
+// Scratch arena settings
+static int SCRATCH_BLK_SZ = 65536;  // min. capacity of a scratch arena block (in bytes)
+static SBlock *SCRATCH_TOP;         // most recently chained block of the scratch arena
+static SBlock *SCRATCH_SPARE;       // largest released block (kept for reuse by the next block chained)
+
+// Screen rendering settings
+#define FRAME_BUF_SZ 16384          // initial capacity of the screen frame buffer (in bytes)
+static int SCR_DIFF_MODE = TRUE;    // repaints only the changed rows of a screen that is redrawn over the one presented (see scrFlush())
+static int SCR_ECHO = TRUE;         // FALSE while console input is not echoed (see setnoecho_console())
+static FBuffer SCR_FRAME;           // output composed since the last flush
+static FBuffer SCR_SHADOW;          // output presented (and input echoed) since the screen was last cleared
+static FBuffer SCR_PAINT;           // repaint sequence of the changed rows
+
+// Timestamp settings
+#define TMS_SZ 32                   // min. buffer size of a formatted timestamp
+static int TMS_MODE = TMS_MODE_SEC;
+static CCache CLOCK_CACHE;
+
 // Log framework control settings
 static char *LOG_NULL_VALUE;        // specifies how NULL messages should be represented in the logs
 
@@ -62,31 +203,292 @@ static int ERROR_MODE = LG_MODE_CONSL, ERROR_TMS_MODE = LG_MODE_FILE;
 static int FATAL_MODE = LG_MODE_CONSL, FATAL_TMS_MODE = LG_MODE_FILE;
 static int DEBUG_MODE, DEBUG_TMS_MODE = LG_MODE_FILE; 
 
+// Log file buffering settings (ERROR and FATAL entries, as well as program exit, always flush the buffered log entries)
+#define LOG_SINK_MAX 6
+static int LOG_BUF_SZ = 8192;       // buffer size of each log file sink (in bytes); 0 disables buffering
+static int LOG_FLUSH_LAT = 2;       // max. age of buffered log entries before they are flushed by the next log entry (in seconds)
+static LSink LOG_SINKS [LOG_SINK_MAX];
+
+// Structured log settings (routes must be re-resolved by scrLogRoute() whenever the level settings above are changed)
+#define LOG_ROUTE_MAX 5
+static int LOG_FMT = LOG_FMT_TEXT;
+static int LOG_ROUTE_CNT;           // no. of resolved routes (0 until scrLogRoute() is called)
+static LRoute LOG_ROUTES [LOG_ROUTE_MAX];
+static LTag LOG_TAG;                // tag of the entries logged by scrLog() (see scrLogTag())
+
 // Mandatory function prototype declarations
 static int   glbMode(char*); 
 static int   glbTMSMode(char*); 
 static char* glbFname(char*, const int);
 static char* glbTitle(char*, const int); 
+static LRoute* glbRoute(const char*);
+static int   scrLogWrite(FILE*, const char*, const char*, const char*, const char*, const LTag*, const char*, const int);
 static char* tmstmp(char*);
 static void* get_console();
 static void* setnoecho_console(void*);
 static void* restore_console(void*, void*);
+static void  scrHookExit();
+int  scrLogFlush();
+void scrLogClose();
 
 
 /********************************************************************/
 /******************** Auxilliary Screen Functions *******************/
 /********************************************************************/
 
+static int scrWriteRaw(const char* buf, int len) {  // writes to the console without going through stdio (async-signal-safe)
+    int wrt_len, off = 0;
+
+    while (off < len) 
+    {
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+        wrt_len = _write(1, buf + off, len - off);
+#else  // Linux OS
+        wrt_len = write(STDOUT_FILENO, buf + off, len - off);
+#endif
+        if (wrt_len < 0 && errno == EINTR)
+            continue;
+        if (wrt_len <= 0)
+            break;
+        off += wrt_len;
+    }
+    return off;
+}
+
+static int scrWrite(const char* buf, int len) {  // writes to the console in as few writes as possible
+    fflush(stdout);  // any output written to stdout directly precedes the frame
+    return scrWriteRaw(buf, len);
+}
+
+static int fbAppend(FBuffer* fb, const char* str, int len) {
+    int cap = fb->cap? fb->cap: FRAME_BUF_SZ;
+    char* buf;
+
+    while (cap <= fb->len + len) {
+        cap *= 2;
+    }
+    if (cap > fb->cap) 
+    {
+        if (!(buf = realloc(fb->buf, cap)))
+            return FALSE;
+        fb->buf = buf;
+        fb->cap = cap;
+    }
+    memcpy(fb->buf + fb->len, str, len);
+    fb->len += len;
+    fb->buf[fb->len] = '\0';
+
+    return TRUE;
+}
+
+int scrDims(int* cols) {  // returns the no. of rows (and columns) of the console window; 0 if the output is not a console
+    int rows = 0;
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+    CONSOLE_SCREEN_BUFFER_INFO csbi;
+
+    if (GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi)) {
+        rows  = csbi.srWindow.Bottom - csbi.srWindow.Top + 1;
+       *cols  = csbi.srWindow.Right - csbi.srWindow.Left + 1;
+    }
+#else  // Linux OS
+    struct winsize ws;
+
+    if (isatty(STDOUT_FILENO) && ioctl(STDOUT_FILENO, TIOCGWINSZ, &ws) == 0) {
+        rows  = ws.ws_row;
+       *cols  = ws.ws_col;
+    }
+#endif
+    return rows;
+}
+
+static int scrFits(const char* frame, int len, int rows, int cols) {  // checks that a frame is displayed without wrapping or scrolling
+    const char *ln = frame, *end = frame + len, *nl;
+
+    for (rows--; ln < end; ln = nl + 1, rows--) {   // a row is kept for the cursor (or the echoed input) below the frame
+        if (!(nl = memchr(ln, '\n', end - ln))) 
+            nl = end;
+        if (rows <= 0 || nl - ln >= cols)
+            return FALSE;
+    }
+    return TRUE;
+}
+
+static int scrScroll(const char* frame, int len, int rows, int cols) {  // returns the no. of rows a presented frame scrolled the console by; -1 if any of its rows wrapped
+    const char *ln = frame, *end = frame + len, *nl;
+    int brks = 0;
+
+    for (; ln < end; ln = nl + 1) {
+        if (!(nl = memchr(ln, '\n', end - ln))) 
+            nl = end;
+        if (nl - ln >= cols)
+            return -1;
+        if (nl < end) 
+            brks++;
+    }
+    return brks + 1 > rows ? brks + 1 - rows : 0;   // the cursor is left on the row below the last line break
+}
+
+static int scrPaint(const char* frame, int len, int scroll) {  // composes the repaint of the rows of the frame that differ from the (visible rows of the) shadow frame
+    const char *ln = frame, *end = frame + len, *nl;
+    const char *old_ln = SCR_SHADOW.buf, *old_end = SCR_SHADOW.buf + SCR_SHADOW.len, *old_nl;
+    char esc [16];
+    int ok_flg = TRUE;
+
+    SCR_PAINT.len = 0;
+
+    if (scroll > 0) 
+    {  // the rows scrolled off the top are brought back in place (blank) and dropped from the scrollback, as a full redraw would
+        sprintf(esc, ANSI_SCROLL_DN, scroll);
+        ok_flg = fbAppend(&SCR_PAINT, ANSI_CLR_HIST, strlen(ANSI_CLR_HIST)) && fbAppend(&SCR_PAINT, esc, strlen(esc));
+    }
+
+    for (int row = 1; ok_flg; row++, ln = nl + 1) 
+    {
+        if (!(nl = memchr(ln, '\n', end - ln))) 
+            nl = end;
+
+        if (old_ln < old_end) {
+            if (!(old_nl = memchr(old_ln, '\n', old_end - old_ln))) 
+                old_nl = old_end;
+        } else {
+            old_nl = NULL;  // beyond the shadow frame
+        }
+
+        // the last row is always repainted, so as to leave the cursor at its end and clear the rows below it
+        if (nl == end || row <= scroll || !old_nl || old_nl == old_end || nl - ln != old_nl - old_ln || memcmp(ln, old_ln, nl - ln)) 
+        {
+            sprintf(esc, ANSI_MOVE, row);
+            ok_flg = fbAppend(&SCR_PAINT, esc, strlen(esc)) && fbAppend(&SCR_PAINT, ln, nl - ln);
+
+            if (ok_flg) {
+                ok_flg = nl == end ? fbAppend(&SCR_PAINT, ANSI_CLR_SCR, strlen(ANSI_CLR_SCR)):
+                                     fbAppend(&SCR_PAINT, ANSI_CLR_LN,  strlen(ANSI_CLR_LN));
+            }
+        }
+        if (nl == end) 
+            break;
+
+        old_ln = old_nl? old_nl + 1: old_end;
+    }
+    return ok_flg;
+}
+
+int scrFlush() {  // presents the composed screen frame to the console in a single write
+    const char *frame = SCR_FRAME.buf, *clr;
+    int rows, cols, len, scroll, diff_flg, result;
+
+    if (!SCR_FRAME.len) 
+        return 0;
+
+    for (clr = strstr(frame, ANSI_CLEAR); clr; clr = strstr(clr + 1, ANSI_CLEAR)) {
+        frame = clr;  // only the output composed since the screen was last cleared remains visible
+    }
+
+    if (frame == SCR_FRAME.buf && strncmp(frame, ANSI_CLEAR, strlen(ANSI_CLEAR))) 
+    {  // the frame continues the one presented
+        result = scrWrite(SCR_FRAME.buf, SCR_FRAME.len);
+        SCR_SHADOW.sync_flg = SCR_SHADOW.sync_flg && fbAppend(&SCR_SHADOW, SCR_FRAME.buf, SCR_FRAME.len);
+    } 
+    else 
+    {
+        frame += strlen(ANSI_CLEAR);
+        len = SCR_FRAME.len - (frame - SCR_FRAME.buf);
+
+        // a screen redrawn over one that still mirrors the console (however many prompts were answered on it) 
+        // has all of its unchanged rows in place, hence only its changed rows are repainted
+        diff_flg = SCR_DIFF_MODE && frame - strlen(ANSI_CLEAR) == SCR_FRAME.buf && SCR_SHADOW.sync_flg && 
+                   (rows = scrDims(&cols)) > 0 && (scroll = scrScroll(SCR_SHADOW.buf, SCR_SHADOW.len, rows, cols)) >= 0 && scroll < rows && 
+                   scrFits(frame, len, rows, cols) && scrPaint(frame, len, scroll);
+
+        result = diff_flg? scrWrite(SCR_PAINT.buf, SCR_PAINT.len): scrWrite(SCR_FRAME.buf, SCR_FRAME.len);
+
+        SCR_SHADOW.len = 0;
+        SCR_SHADOW.sync_flg = fbAppend(&SCR_SHADOW, frame, len);   // an incomplete shadow frame cannot be repainted by rows
+    }
+    SCR_FRAME.len = 0;
+
+    return result;
+}
+
+void scrAwait() {  // presents the screen before console input is awaited
+    scrFlush();
+}
+
+void scrEcho(const char* input) {  // accounts for console input echoed onto the screen presented
+    int len = strlen(input);
+
+    if (!SCR_ECHO) 
+        return;  // nothing was echoed, not even the line break
+    if (!len || input[len - 1] != '\n') 
+        SCR_SHADOW.sync_flg = FALSE;  // the rest of the echoed line is consumed elsewhere
+    else 
+        SCR_SHADOW.sync_flg = SCR_SHADOW.sync_flg && fbAppend(&SCR_SHADOW, input, len);
+}
+
+int printScrf(const char* format, ...) {  // composes formatted output into the screen frame buffer
+    va_list args;
+    int len, cap = SCR_FRAME.cap - SCR_FRAME.len;
+    char* buf;
+
+    va_start(args, format);
+    len = vsnprintf(SCR_FRAME.buf? SCR_FRAME.buf + SCR_FRAME.len: NULL, cap, format, args);
+    va_end(args);
+
+    if (len < cap || len < 0) 
+    {
+        if (len > 0) {
+            SCR_FRAME.len += len;
+        }
+        return len;
+    }
+
+    // grow the frame buffer and re-compose the output into it
+    for (cap = SCR_FRAME.cap? SCR_FRAME.cap: FRAME_BUF_SZ; cap <= SCR_FRAME.len + len; cap *= 2);
+
+    if (!(buf = realloc(SCR_FRAME.buf, cap))) 
+    {  // fall back to unbuffered output
+        scrFlush();
+        va_start(args, format);
+        len = vprintf(format, args);
+        va_end(args);
+        return len;
+    }
+
+    if (!SCR_FRAME.buf) {
+        scrHookExit();
+    }
+    SCR_FRAME.buf = buf;
+    SCR_FRAME.cap = cap;
+
+    va_start(args, format);
+    len = vsnprintf(SCR_FRAME.buf + SCR_FRAME.len, cap - SCR_FRAME.len, format, args);
+    va_end(args);
+
+    SCR_FRAME.len += len;
+    return len;
+}
+
 void clearScr() {
-#if defined(_WIN32) || defined(__CYGWIN__)
-    system ("cls");   // Windows OS
-#else
-    system ("clear"); // other OS
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+    static int vt_flg = -1;
+
+    if (vt_flg < 0) 
+    {  // enable ANSI control sequence support on the console
+        HANDLE hStdout = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        vt_flg = GetConsoleMode(hStdout, &mode) && SetConsoleMode(hStdout, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+    }
+    if (!vt_flg) {
+        scrFlush();
+        system ("cls");
+        return;
+    }
 #endif
+    printScrf (ANSI_CLEAR);
 }
 
 void printScrHMargin(int hMargin) {
-    printf("%*s", hMargin < 0 ? 0 :hMargin, "");
+    printScrf("%*s", hMargin < 0 ? 0 :hMargin, "");
 }
 
 void printScrVMargin(int vMargin) {
@@ -104,12 +506,12 @@ void printScrMargin(int vMargin) {
 
 void printScrPat(const char* pre_pat, const char* pattern, int repeat, const char* pst_pat) { 
     if (pre_pat)
-        printf (pre_pat);
+        printScrf (pre_pat);
     if (pattern)
     for (int i=0; i <= repeat; i++)
-        printf (pattern);
+        printScrf (pattern);
     if (pst_pat)
-        printf (pst_pat);
+        printScrf (pst_pat);
 }
 
 void printScrTitle(const char* pre_pat, const char* title, const char* pst_pat) {
@@ -121,12 +523,12 @@ void printScrTitle(const char* pre_pat, const char* title, const char* pst_pat)
 
     if (pre_pat) {
         margin -= strlen(pre_pat);
-        printf (pre_pat);
+        printScrf (pre_pat);
     }
     if (title) 
-        printf ("%*s", (margin < 0 ? 0 : margin) + TTL_SZ, title);
+        printScrf ("%*s", (margin < 0 ? 0 : margin) + TTL_SZ, title);
     if (pst_pat) 
-        printf ("%*s", (margin < 0 ? margin : 0) + DEF_MRGN, pst_pat);    
+        printScrf ("%*s", (margin < 0 ? margin : 0) + DEF_MRGN, pst_pat);    
 }
 
 void printScrTopic(const char* caption, int cap_sz, const char* pattern, int margin, const int ovr_bnd_flg) 
@@ -134,7 +536,7 @@ void printScrTopic(const char* caption, int cap_sz, const char* pattern, int mar
     if (caption || cap_sz >= 0) {
         if (caption) {
             printScrHMargin(margin);
-            printf("%s\n", caption);
+            printScrf("%s\n", caption);
         }
         if (pattern) {
             int reps = 0;
@@ -212,17 +614,17 @@ int printScrHeader(const char* col_txt1, int col_sz1, const char* col_txt2, int
 
 void printScrColText(const char* col_txt, int col_txt_sz, const char* pst_txt) {
     if (col_txt) 
-        printf ("%-*s", col_txt_sz, col_txt); 
+        printScrf ("%-*s", col_txt_sz, col_txt); 
     if (pst_txt)
-        printf (pst_txt);
+        printScrf (pst_txt);
 }
 
 void printScrColVal(float col_val, int col_val_sz, int col_val_prec, const char* pst_txt) {
     
-    printf ("%-*.*f", col_val_sz, col_val_prec < 0 ? 0 :col_val_prec, col_val); 
+    printScrf ("%-*.*f", col_val_sz, col_val_prec < 0 ? 0 :col_val_prec, col_val); 
     
     if (pst_txt)
-        printf (pst_txt);
+        printScrf (pst_txt);
 }
 
 
@@ -299,14 +701,11 @@ int isEmptyStr(char* str, const int is_blnk_flg, char* trstr)
     if (is_blnk_flg < TRUE)
         return FALSE;
 
-    int   strsz = -1;
-    char* trtmp = trstr;
-
-    if (!trtmp) {
-        strsz = strlen(str);
-        trtmp = malloc((strsz + 1) *sizeof(char));
+    if (!trstr) {   // no trimmed copy is required, so only look for a non-blank character
+        while (*str && isspace(*str)) str++;
+        return !*str;
     }
-    return !*trim(str, strsz, trtmp, FTRIM);
+    return !*trim(str, -1, trstr, FTRIM);
 }
 
 int isDigitStr(char* str, const int is_zero_flg, const int len_mode_flg) 
@@ -360,13 +759,75 @@ int isPrintStr(char* str, const int len_mode_flg)
     return !len_mode_flg;
 }
 
+void *scratchAlloc(int sz)  // allocates a transient buffer, valid until the scratch arena is released to a mark taken before it
+{
+    SBlock* blk = SCRATCH_TOP;
+    int cap;
+
+    if (sz < 0) 
+        return NULL;
+
+    sz = (sz + 15) & ~15;   // keeps every buffer suitably aligned
+
+    if (!blk || blk->capacity - blk->size < sz) 
+    {
+        cap = blk && blk->capacity * 2 > SCRATCH_BLK_SZ ? blk->capacity * 2 : SCRATCH_BLK_SZ;
+        if (cap < sz) cap = sz;
+
+        if (SCRATCH_SPARE && SCRATCH_SPARE->capacity >= sz) {
+            blk = SCRATCH_SPARE;
+            SCRATCH_SPARE = NULL;
+        } 
+        else if ((blk = malloc(sizeof(SBlock) + cap))) {
+            blk->capacity = cap;
+        } 
+        else return NULL;
+
+        blk->prev = SCRATCH_TOP;
+        blk->size = 0;
+        SCRATCH_TOP = blk;
+    }
+    blk->size += sz;
+
+    return blk->data + blk->size - sz;
+}
+
+SMark scratchMark() {  // takes the current position of the scratch arena
+    SMark mark = {SCRATCH_TOP, SCRATCH_TOP ? SCRATCH_TOP->size : 0};
+    return mark;
+}
+
+void scratchRelease(SMark mark)  // releases every scratch buffer allocated since the mark was taken
+{
+    SBlock* blk;
+
+    while ((blk = SCRATCH_TOP) && blk != mark.blk) 
+    {
+        SCRATCH_TOP = blk->prev;
+
+        if (!SCRATCH_SPARE || SCRATCH_SPARE->capacity < blk->capacity) {
+            free(SCRATCH_SPARE);
+            SCRATCH_SPARE = blk;
+        } else {
+            free(blk);
+        }
+    }
+    if (SCRATCH_TOP) {
+        SCRATCH_TOP->size = mark.size;
+    }
+}
+
 
 /*******************************************************************/
 /******************** Rudimentary I/O Functions ********************/
 /*******************************************************************/
 
 void flush() {
+    scrAwait();  // the screen is presented before console input is awaited
     while (getchar() != '\n');  // clear console input stream (remove unconsumed input characters)
+
+    if (SCR_ECHO) 
+        SCR_SHADOW.sync_flg = FALSE;  // the discarded characters were echoed
 }
 
 char *readChars(char* input, int input_sz, FILE* stream) {
@@ -376,6 +837,11 @@ char *readChars(char* input, int input_sz, FILE* stream) {
 
         int spn_len, retry = 0;
 
+        if (stream == stdin) {
+            scrAwait();     // the screen is presented before console input is awaited
+            scrLogFlush();  // buffered log entries are written while the screen waits on the user
+        }
+
         result = fgets(input, input_sz + 1, stream);  // fgets actually reads input_sz - 1 characters from the input stream
 
         while (!result && retry++ < FILE_READ_FRQ) {
@@ -384,6 +850,9 @@ char *readChars(char* input, int input_sz, FILE* stream) {
         }
 
         if (result) {
+            if (stream == stdin) 
+                scrEcho(input);
+
             spn_len = strcspn(input, "\n");
 
             if (spn_len < input_sz) {
@@ -436,22 +905,325 @@ float* freadFloat(float* input, FILE* fptr) {
     return freadVal(input, "%f\n", fptr);
 }
 
+int splitCSV(char* line, char** fields, int max_fields) {  // splits a CSV record in place (double-quoted fields may contain commas and "" escapes); returns the field count
+    char *src = line, *dst;
+    int cnt = 0, more;
+
+    line[strcspn(line, "\r\n")] = '\0';
+
+    while (cnt < max_fields) 
+    {
+        fields[cnt++] = dst = src;
+
+        if (*src == '"') {   // quoted field
+            for (src++; *src; ) {
+                if (*src == '"' && src[1] != '"') {
+                    src++; break;   // closing quote
+                }
+                if (*src == '"') {
+                    src++;          // escaped quote
+                }
+               *dst++ = *src++;
+            }
+            while (*src && *src != ',') {   // ignore any characters between the closing quote and the delimiter
+                src++;
+            }
+        } 
+        else {
+            while (*src && *src != ',') {
+               *dst++ = *src++;
+            }
+        }
+
+        more = *src == ',';
+       *dst  = '\0';
+
+        if (!more) break;
+        src++;
+    }
+    return cnt;
+}
+
+char *mreadTok(char* token, int token_sz, MCursor* cur) {  // reads a whitespace-delimited token, skipping any trailing whitespace
+    int len = 0;
+
+    while (cur->pos < cur->end && isspace((unsigned char) *cur->pos)) {
+        cur->pos++;
+    }
+    for (; cur->pos < cur->end && !isspace((unsigned char) *cur->pos); cur->pos++) {
+        if (len < token_sz - 1)
+            token[len++] = *cur->pos;
+    }
+    while (cur->pos < cur->end && isspace((unsigned char) *cur->pos)) {
+        cur->pos++;
+    }
+    token[len] = '\0';
+
+    return len > 0 ? token : NULL;
+}
+
+char *mreadChars(char* input, int input_sz, MCursor* cur) {  // memory counterpart of readChars
+    int len = 0;
+
+    if (!(cur && input && input_sz > 0) || cur->pos >= cur->end)
+        return NULL;
+
+    while (len < input_sz && cur->pos < cur->end && *cur->pos != '\n') {
+        input[len++] = *cur->pos++;
+    }
+    if (cur->pos < cur->end && *cur->pos == '\n') {
+        cur->pos++;
+    }
+    if (len > 0 && input[len-1] == '\r') {   // line was terminated by a CRLF sequence
+        len--;
+    }
+    input[len] = '\0';
+
+    return input;
+}
+
+int* mreadInt(int* input, MCursor* cur) {  // memory counterpart of freadInt
+    char token [24], *end;
+    long val;
+
+    if (!(cur && mreadTok(token, sizeof(token), cur)))
+        return NULL;
+
+    val = strtol(token, &end, 10);
+    if (end == token)
+        return NULL;
+
+   *input = (int) val;
+    return input;
+}
+
+float* mreadFloat(float* input, MCursor* cur) {  // memory counterpart of freadFloat
+    char token [48], *end;
+    double val;
+
+    if (!(cur && mreadTok(token, sizeof(token), cur)))
+        return NULL;
+
+    val = strtod(token, &end);
+    if (end == token)
+        return NULL;
+
+   *input = (float) val;
+    return input;
+}
+
+void *fmap(const char* fname, long* fsz) {  // maps the entire content of a file into memory (read-only)
+    void* addr = NULL;
+   *fsz = 0;
+
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+    LARGE_INTEGER size;
+    HANDLE hMap, hFile = CreateFileA(fname, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (hFile == INVALID_HANDLE_VALUE)
+        return NULL;
+
+    if (GetFileSizeEx(hFile, &size) && size.QuadPart > 0 && (hMap = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL))) {
+        addr = MapViewOfFile(hMap, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(hMap);   // the mapped view keeps the mapping alive
+    }
+    if (addr) {
+       *fsz = (long) size.QuadPart;
+    }
+    CloseHandle(hFile);
+
+#else  // Linux OS
+    struct stat st;
+    int fd = open(fname, O_RDONLY);
+
+    if (fd < 0)
+        return NULL;
+
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        addr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+        if (addr == MAP_FAILED)
+            addr = NULL;
+        else
+           *fsz = (long) st.st_size;
+    }
+    close(fd);   // the mapping remains valid after the descriptor is closed
+#endif
+
+    return addr;
+}
+
+void funmap(void* addr, long fsz) {
+    if (!addr) return;
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+    UnmapViewOfFile(addr);
+#else  // Linux OS
+    munmap(addr, fsz);
+#endif
+}
+
+int fstamp(const char* fname, long* fsz, time_t* fmtm, long* fid) {  // gets the size, last modification time and file serial no. (inode) of a file
+    struct stat st;
+
+    if (!fname || stat(fname, &st) != 0)
+        return FALSE;
+
+   *fsz  = (long) st.st_size;
+   *fmtm = st.st_mtime;
+   *fid  = (long) st.st_ino;   // NOTE: always 0 on Windows
+    return TRUE;
+}
+
+int lockFile(const char* fname, const int excl_flg) {  // waits for an advisory lock (exclusive or shared) on a lock file, creating it if needed; returns the lock handle, -1 upon failure
+#if defined(_WIN32) && !defined(__CYGWIN__)  // Windows OS (Cygwin provides POSIX file locks)
+    OVERLAPPED ovl = {0};
+    int fd = _open(fname, _O_RDWR | _O_CREAT, _S_IREAD | _S_IWRITE);
+
+    if (fd < 0)
+        return -1;
+
+    if (!LockFileEx((HANDLE) _get_osfhandle(fd), excl_flg? LOCKFILE_EXCLUSIVE_LOCK: 0, 0, MAXDWORD, MAXDWORD, &ovl)) {
+        _close(fd);
+        return -1;
+    }
+#else  // Linux OS (or Cygwin)
+    struct flock fl = {0};
+    int fd = open(fname, O_RDWR | O_CREAT, 0666);
+
+    if (fd < 0)
+        return -1;
+
+    fl.l_type   = excl_flg? F_WRLCK: F_RDLCK;
+    fl.l_whence = SEEK_SET;   // a zero l_start and l_len covers the entire file
+
+    while (fcntl(fd, F_SETLKW, &fl) < 0) {
+        if (errno != EINTR) {   // e.g. EDEADLK when waiting would deadlock with another process
+            close(fd);
+            return -1;
+        }
+    }
+#endif
+    return fd;
+}
+
+void unlockFile(int lck) {  // NOTE: on Linux, closing ANY descriptor of a lock file releases all of the process' locks on it
+    if (lck < 0) return;
+#if defined(_WIN32) && !defined(__CYGWIN__)  // Windows OS (Cygwin provides POSIX file locks)
+    OVERLAPPED ovl = {0};
+    UnlockFileEx((HANDLE) _get_osfhandle(lck), 0, MAXDWORD, MAXDWORD, &ovl);
+    _close(lck);
+#else  // Linux OS (or Cygwin)
+    close(lck);
+#endif
+}
+
+int fsyncf(FILE* fptr) {  // flushes a file stream through to the storage device
+    if (!fptr || fflush(fptr) != 0)
+        return FALSE;
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+    return _commit(_fileno(fptr)) == 0;
+#else  // Linux OS
+    return fsync(fileno(fptr)) == 0;
+#endif
+}
+
+int freplace(const char* src_fname, const char* dst_fname) {  // atomically replaces a file with another (renaming the latter)
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+    return MoveFileExA(src_fname, dst_fname, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else  // Linux OS
+    return rename(src_fname, dst_fname) == 0;
+#endif
+}
+
+int cpuCount() {  // gets the no. of online processors
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int) info.dwNumberOfProcessors : 1;
+#else  // Linux OS
+    long cnt = sysconf(_SC_NPROCESSORS_ONLN);
+    return cnt > 0 ? (int) cnt : 1;
+#endif
+}
+
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+static DWORD WINAPI runTask(LPVOID task) {
+    ((PTask*) task)->fn(((PTask*) task)->arg);
+    return 0;
+}
+#else  // Linux OS
+static void* runTask(void* task) {
+    ((PTask*) task)->fn(((PTask*) task)->arg);
+    return NULL;
+}
+#endif
+
+int runParallel(PTask* tasks, int task_cnt) {  // runs the tasks on worker threads (the first on the calling thread) and waits for all of them; returns the no. of threads started
+    int thrd_cnt = 0;
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+    HANDLE* thrds = calloc(task_cnt, sizeof(HANDLE));
+
+    for (int i = 1; thrds && i < task_cnt; i++) {
+        if ((thrds[i] = CreateThread(NULL, 0, runTask, tasks + i, 0, NULL)))
+            thrd_cnt++;
+        else
+            runTask(tasks + i);   // run inline when no thread can be started
+    }
+    if (task_cnt > 0)
+        runTask(tasks);
+    for (int i = 1; thrds && i < task_cnt; i++) {
+        if (thrds[i]) {
+            WaitForSingleObject(thrds[i], INFINITE);
+            CloseHandle(thrds[i]);
+        }
+    }
+#else  // Linux OS
+    pthread_t* thrds = calloc(task_cnt, sizeof(pthread_t));
+    char* started    = calloc(task_cnt, sizeof(char));
+
+    if (!started) {
+        free(thrds);
+        thrds = NULL;
+    }
+    for (int i = 1; thrds && i < task_cnt; i++) {
+        if (pthread_create(thrds + i, NULL, runTask, tasks + i) == 0)
+            started[i] = TRUE, thrd_cnt++;
+        else
+            runTask(tasks + i);   // run inline when no thread can be started
+    }
+    if (task_cnt > 0)
+        runTask(tasks);
+    for (int i = 1; thrds && i < task_cnt; i++) {
+        if (started[i])
+            pthread_join(thrds[i], NULL);
+    }
+    free(started);
+#endif
+    if (!thrds) {   // no memory for the thread handles; run all the tasks inline
+        for (int i = 1; i < task_cnt; i++)
+            runTask(tasks + i);
+    }
+    free(thrds);
+
+    return thrd_cnt;
+}
+
 void readOption(int* input) {
     readInt(input, OPTION_MAX_SZ + 1, stdin);
 }
 
 void promptInt(const char * message, int* input, int max_digits) {  // reads an integer value on the console input stream
-    printf (message);
+    printScrf (message);
     readInt(input, max_digits + 1, stdin);
 }
 
 void promptLn(const char * message, char* input, int input_sz) {  // reads an entire line of characters on the console input stream
-    printf (message);
+    printScrf (message);
     readChars(input, input_sz, stdin);
 }
 
 void promptLgn(const char * message, char* input, int input_sz) {  // captures line of characters on the console input stream without displaying it
-    printf(message);
+    printScrf(message);
     void* rfCnsl = get_console();
     void* oMode = setnoecho_console(rfCnsl);
     readChars(input, input_sz, stdin);
@@ -459,9 +1231,9 @@ void promptLgn(const char * message, char* input, int input_sz) {  // captures l
 }
 
 void pauseScr(const char * message, const int alt_msg_flg) {
-    printf (message);
+    printScrf (message);
     if (alt_msg_flg > FALSE) {
-        printf ("\nPress ENTER key to continue");
+        printScrf ("\nPress ENTER key to continue");
     }
     void* rfCnsl = get_console();
     void* oMode = setnoecho_console(rfCnsl);
@@ -469,18 +1241,217 @@ void pauseScr(const char * message, const int alt_msg_flg) {
     restore_console(rfCnsl, oMode);
 }
 
+void scrLogClose() {  // flushes and closes all log file sinks
+    for (LSink *sink = LOG_SINKS; sink < LOG_SINKS + LOG_SINK_MAX; sink++) {
+        if (sink->fptr) {
+            fclose(sink->fptr);
+            sink->fptr = NULL;
+        }
+    }
+}
+
+static void scrExit() {  // presents any pending screen output and closes the log files upon program exit
+    scrFlush();
+    scrLogClose();
+}
+
+static void scrAbort(int sig) {  // presents any pending screen output before the program is terminated by a signal
+    // NOTE: only the frame already composed is written, as stdio and the heap are not async-signal-safe; 
+    //       buffered log entries are flushed at each input wait and upon exit
+    scrWriteRaw(SCR_FRAME.buf, SCR_FRAME.len);
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+static void scrHookExit() {
+    static int exit_hook_flg = FALSE;
+
+    if (!exit_hook_flg) {
+        exit_hook_flg = atexit(scrExit) == 0;
+        signal(SIGINT,  scrAbort);
+        signal(SIGTERM, scrAbort);
+    }
+}
+
+static LSink *scrLogSink(char* fname, const int open_flg) {  // finds (or opens) the sink of a log file
+    LSink *sink, *free_sink = NULL;
+
+    for (sink = LOG_SINKS; sink < LOG_SINKS + LOG_SINK_MAX; sink++) {
+        if (sink->fptr && !strcmp(sink->fname, fname))
+            return sink;
+        if (!sink->fptr && !free_sink)
+            free_sink = sink;
+    }
+
+    if (!open_flg || !free_sink || !(free_sink->fptr = fopen(fname, "a")))
+        return NULL;
+
+    scrHookExit();
+
+    if (LOG_BUF_SZ > 0) {
+        setvbuf(free_sink->fptr, NULL, _IOFBF, LOG_BUF_SZ);
+    }
+    free_sink->fname = fname;
+    free_sink->dirty = 0;
+
+    return free_sink;
+}
+
+int scrLogFlush() {   // writes out all buffered log entries
+    int result = 0;
+
+    for (LSink *sink = LOG_SINKS; sink < LOG_SINKS + LOG_SINK_MAX; sink++) {
+        if (sink->fptr && sink->dirty) {
+            if (fflush(sink->fptr) != 0) 
+                result = -1;
+            sink->dirty = 0;
+        }
+    }
+    return result;
+}
+
 int scrLogInit(char* level) {
     int fresult = -1;
     char* fname = glbFname(level, TRUE);
     FILE* fptr; 
+    LSink* sink;
+
+    if (fname && (sink = scrLogSink(fname, FALSE))) {  // the log file is about to be truncated
+        fclose(sink->fptr);
+        sink->fptr = NULL;
+
+        for (int i = 0; i < LOG_ROUTE_CNT; i++) {
+            if (LOG_ROUTES[i].sink == sink) 
+                LOG_ROUTES[i].sink = NULL;
+        }
+    }
 
-    if (fname && (fptr = fopen(fname, "w"))) {
-        fresult = fprintf(fptr, "*************** %s ***************", glbTitle(level, TRUE));
+    if (fname && (fptr = fopen(fname, LOG_FMT == LOG_FMT_BIN? "wb":"w"))) {
+        if (LOG_FMT == LOG_FMT_TEXT) {
+            fresult = fprintf(fptr, "*************** %s ***************", glbTitle(level, TRUE));
+        } else {  // structured logs open with an INFO record holding the title
+            fresult = scrLogWrite(fptr, LVL_INFO, "", "", "", NULL, glbTitle(level, TRUE), FALSE);
+        }
         fclose(fptr);
     }
     return fresult;
 }
 
+void scrLogRoute() {  // resolves the mode, timestamp mode and file of each log level
+    const char *levels [] = {LVL_INFO, LVL_WARN, LVL_ERROR, LVL_FATAL, LVL_DEBUG};
+    const char *names  [] = {"INFO",   "WARN",   "ERROR",   "FATAL",   "DEBUG"};
+
+    LOG_ROUTE_CNT = 0;  // the routes are resolved from the global level settings
+
+    for (int i = 0; i < LOG_ROUTE_MAX; i++) {
+        LOG_ROUTES[i].level    = levels[i];
+        LOG_ROUTES[i].name     = names[i];
+        LOG_ROUTES[i].mode     = glbMode((char*) levels[i]);
+        LOG_ROUTES[i].tms_mode = glbTMSMode((char*) levels[i]);
+        LOG_ROUTES[i].fname    = glbFname((char*) levels[i], FALSE);
+        LOG_ROUTES[i].sink     = NULL;
+    }
+    LOG_ROUTE_CNT = LOG_ROUTE_MAX;
+}
+
+static int scrLogWrite(FILE* fptr, const char* level, const char* alt_level, const char* tms, const char* NL, const LTag* tag, const char* msg, const int cntd_lg_flg) 
+{
+    static const LTag no_tag;
+    LRoute* route;
+    const char* name;
+    int result;
+
+    if (!tag) tag = &no_tag;
+
+    switch (LOG_FMT) 
+    {
+        case LOG_FMT_JSON:
+            name = (route = glbRoute(level))? route->name: "INFO";
+            result = fprintf(fptr, "{\"ts\":%lld,\"level\":\"%s\",\"list\":%d,\"key\":%d,\"rec\":%d,\"msg\":\"", (long long) time(NULL), name, tag->lst_type, tag->entry_key, tag->rec_no);
+
+            for (const char *c = msg; result >= 0 && *c; c++) {
+                if (*c == '"' || *c == '\\') {
+                    result = fprintf(fptr, "\\%c", *c) < 0 ? -1: result + 2;
+                } else if ((unsigned char) *c < ' ') {
+                    result = fprintf(fptr, "\\u%04x", (unsigned char) *c) < 0 ? -1: result + 6;
+                } else {
+                    result = fputc(*c, fptr) == EOF ? -1: result + 1;
+                }
+            }
+            return result < 0 || fputs("\"}\n", fptr) == EOF ? -1: result + 3;
+
+        case LOG_FMT_BIN: 
+        {
+            LBinRec rec;
+            size_t msg_len = strlen(msg);
+
+            if (msg_len > INT16_MAX) {
+                msg_len = INT16_MAX;
+            }
+            name = (route = glbRoute(level))? route->name: "INFO";
+            memset(&rec, 0, sizeof(rec));  // clears the header's padding bytes
+            rec.tms       = (int64_t) time(NULL);
+            rec.lst_type  = tag->lst_type;
+            rec.entry_key = tag->entry_key;
+            rec.rec_no    = tag->rec_no;
+            rec.msg_len   = (int16_t) msg_len;
+            rec.level     = name[0];
+            rec.cntd_flg  = cntd_lg_flg > FALSE;
+
+            if (fwrite(&rec, sizeof(rec), 1, fptr) != 1 || fwrite(msg, 1, msg_len, fptr) != msg_len)
+                return -1;
+            return sizeof(rec) + msg_len;
+        }
+
+        default:
+            return fprintf(fptr, "%s%s%s%s", NL, tms, alt_level, msg);
+    }
+}
+
+static int scrLogFile(const char* level, const char* alt_level, const char* tms, const char* NL, const LTag* tag, const char* msg, const int cntd_lg_flg) 
+{
+    int fresult = -1;
+    LRoute* route = glbRoute(level);
+    LSink* sink = route? route->sink: NULL;
+    char* fname;
+
+    if (!sink && (fname = route? route->fname: glbFname((char*) level, FALSE)) && (sink = scrLogSink(fname, TRUE)) && route) {
+        route->sink = sink;
+    }
+
+    if (sink) {
+        fresult = scrLogWrite(sink->fptr, level, alt_level, tms, NL, tag, msg, cntd_lg_flg);
+
+        if (!sink->dirty) {
+            sink->dirty = time(NULL);
+        }
+        if (!strcmp(level, LVL_ERROR) || !strcmp(level, LVL_FATAL) || time(NULL) - sink->dirty >= LOG_FLUSH_LAT) {
+            scrLogFlush();  // also flushes the other sinks, so as to preserve the order of entries across log files
+        }
+    }
+    return fresult;
+}
+
+void scrLogTag(int lst_type, int entry_key, int rec_no) {  // tags the entries logged hereafter (until the tag is cleared by passing zeros)
+    LOG_TAG.lst_type  = lst_type;
+    LOG_TAG.entry_key = entry_key;
+    LOG_TAG.rec_no    = rec_no;
+}
+
+int scrLogRec(const char* level, int lst_type, int entry_key, int rec_no, char* msg)  // logs a (file only) entry about a given entry (or import record) of a given list
+{
+    LTag tag = {lst_type, entry_key, rec_no};
+    char tms[TMS_SZ] = "";
+
+    if (!msg) {
+        msg = LOG_NULL_VALUE? LOG_NULL_VALUE:"";
+    }
+    if (glbTMSMode((char*) level) >= LG_MODE_FILE) {
+        tmstmp(tms);
+    }
+    return scrLogFile(level, level, tms, "\n", &tag, msg, FALSE);
+}
+
 int scrLog(const char* level, char* alt_level, int mode, int tms_mode, const int cntd_lg_flg, char* msg, ...) 
 {
     if (!msg) {                                     // formatting NULL message display
@@ -490,9 +1461,8 @@ int scrLog(const char* level, char* alt_level, int mode, int tms_mode, const int
     if (cntd_lg_flg && !isPrintStr(msg, TRUE))     // short-circuiting unprintable message
         return 0; 
 
-    const char* LOG_HDR_FMT = "%s%s%s";
     const char* NL = cntd_lg_flg > FALSE ? "":"\n";
-    char fmt[strlen(LOG_HDR_FMT) + strlen(msg) + 1], tms[25];
+    char tms[TMS_SZ];
     int result = 0;
 
     if (cntd_lg_flg > FALSE) {
@@ -511,31 +1481,21 @@ int scrLog(const char* level, char* alt_level, int mode, int tms_mode, const int
         tms_mode = glbTMSMode(level);
     }
 
-    if (cntd_lg_flg > FALSE) {
+    if (cntd_lg_flg > FALSE || tms_mode <= LG_MODE_OFF) {
         tms[0] = '\0';
     } 
-    else 
-    if (tms_mode > LG_MODE_OFF) {
-        tmstmp(&tms);
+    else {
+        tmstmp(tms);
     }
 
     if (mode >= LG_MODE_CONSL && mode != LG_MODE_FILE) 
     {
-        strcpy(fmt, LOG_HDR_FMT); strcat(fmt, msg);
-        result = fprintf(stdout, fmt, NL, tms_mode >= LG_MODE_CONSL && tms_mode != LG_MODE_FILE ? tms : "", alt_level);
+        result = printScrf("%s%s%s%s", NL, tms_mode >= LG_MODE_CONSL && tms_mode != LG_MODE_FILE ? tms : "", alt_level, msg);
     }
 
     if (mode >= LG_MODE_FILE) 
     {
-        int fresult = -1;
-        char* fname = glbFname(level, FALSE);
-        FILE* fptr;
-
-        if (fname && (fptr = fopen(fname, "a"))) {
-            strcpy(fmt, LOG_HDR_FMT); strcat(fmt, msg);
-            fresult = fprintf(fptr, fmt, NL, tms_mode >= LG_MODE_FILE ? tms : "", alt_level);
-            fclose(fptr);
-        }
+        int fresult = scrLogFile(level, alt_level, tms_mode >= LG_MODE_FILE ? tms : "", NL, &LOG_TAG, msg, cntd_lg_flg);
 
         if (result < 0 && fresult < 0 || result > 0 && fresult > 0) {
             result += fresult;
@@ -613,8 +1573,22 @@ int scrCnslDbg(int t_margin, int b_margin, char* alt_level, char* msg, int scr_p
 }
 
 
+static LRoute *glbRoute(const char* level) 
+{
+    for (int i = 0; i < LOG_ROUTE_CNT; i++) {
+        if (LOG_ROUTES[i].level == level) 
+            return LOG_ROUTES + i;
+    }
+    return NULL;
+}
+
 static int glbMode(char* level) 
 {
+    LRoute* route = glbRoute(level);
+
+    if (route)
+        return route->mode;
+    else
     if (level == NULL)
         return -1;
     else
@@ -635,6 +1609,11 @@ static int glbMode(char* level)
 
 static int glbTMSMode(char* level) 
 {
+    LRoute* route = glbRoute(level);
+
+    if (route)
+        return route->tms_mode;
+    else
     if (level == NULL)
         return -1;
     else
@@ -709,10 +1688,61 @@ static char *glbTitle(char* level, const int strict_mode_flg)
     return title;
 }
 
-static char *tmstmp(char* tms) {
-    time_t t = time(NULL);
-    struct tm* tm = localtime(&t);
-    strftime(tms, 25, "[%Y-%m-%d %H:%M:%S] ", tm);
+static struct tm *clockAt(time_t t) {
+    if (t != CLOCK_CACHE.sec || !*CLOCK_CACHE.tms) {
+        CLOCK_CACHE.sec = t;
+        CLOCK_CACHE.tm  = *localtime(&t);
+        strftime(CLOCK_CACHE.tms, sizeof(CLOCK_CACHE.tms), "[%Y-%m-%d %H:%M:%S", &CLOCK_CACHE.tm);
+    }
+    return &CLOCK_CACHE.tm;
+}
+
+struct tm *clockTm() {  // returns the current local time (NOTE: the result is shared, hence it should be copied before being modified)
+    return clockAt(time(NULL));
+}
+
+long long clockMs(const int mono_flg) {  // returns the milliseconds elapsed since the epoch, or since the first monotonic reading
+    static long long mono_base = -1;
+    long long ms;
+
+    if (!mono_flg) {
+        struct timespec ts;
+        timespec_get(&ts, TIME_UTC);
+        return ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
+    }
+#if defined(_WIN32) || defined(__CYGWIN__)  // Windows OS
+    ms = (long long) GetTickCount64();
+#else  // Linux OS
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ms = ts.tv_sec * 1000LL + ts.tv_nsec / 1000000;
+#endif
+    if (mono_base < 0) {
+        mono_base = ms;
+    }
+    return ms - mono_base;
+}
+
+static char *tmstmp(char* tms) {  // formats the current timestamp as per TMS_MODE (tms must hold at least TMS_SZ characters)
+    long long ms;
+
+    switch (TMS_MODE) 
+    {
+        case TMS_MODE_MONO:
+            ms = clockMs(TRUE);
+            sprintf(tms, "[+%lld.%03lld] ", ms / 1000, ms % 1000);
+            break;
+
+        case TMS_MODE_MS:
+            ms = clockMs(FALSE);
+            clockAt((time_t) (ms / 1000));
+            sprintf(tms, "%s.%03lld] ", CLOCK_CACHE.tms, ms % 1000);
+            break;
+
+        default:
+            clockTm();
+            strcpy(tms, CLOCK_CACHE.tms); strcat(tms, "] ");
+    }
     return tms;
 }
 
@@ -765,8 +1795,9 @@ static void *setnoecho_console(void* rfCnsl)
 
     if (!SetConsoleMode(rfCnsl, *(DWORD*)nMode) )
         return NULL;
-    else
-        return oMode;
+    
+    SCR_ECHO = FALSE;
+    return oMode;
 
 #else   // Linux OS
     if (!oMode) 
@@ -787,8 +1818,9 @@ static void *setnoecho_console(void* rfCnsl)
 
     if (tcsetattr (*(int*)rfCnsl, TCSAFLUSH, (struct termios*)nMode) != 0)
         return NULL;
-    else
-        return oMode;
+
+    SCR_ECHO = FALSE;
+    return oMode;
 
 #endif
 }
@@ -802,16 +1834,18 @@ static void *restore_console(void* rfCnsl, void* oMode)
     // Restore input mode on exit.
     if (!SetConsoleMode(rfCnsl, *(DWORD*)oMode))
         return NULL;
-    else
-        return rfCnsl;
+
+    SCR_ECHO = TRUE;
+    return rfCnsl;
 
 #else   // Linux OS
     
     /* Restore terminal. */
     if (tcsetattr (*(int*)rfCnsl, TCSAFLUSH, (struct termios*)oMode) != 0)
         return NULL;
-    else
-        return rfCnsl;
+
+    SCR_ECHO = TRUE;
+    return rfCnsl;
 
 #endif
 }